@@ -0,0 +1,64 @@
+// Create brokers attached to new in-memory stages and report the time spent
+// per creation.
+//
+// Usage: unfBrokerCreation [iterations]
+
+#include <unf/broker.h>
+
+#include <pxr/pxr.h>
+#include <pxr/usd/usd/common.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+int main(int argc, char* argv[])
+{
+    const int iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 1000;
+
+    // Stages are created beforehand so that only the broker creation is
+    // measured.
+    std::vector<UsdStageRefPtr> stages;
+    for (int i = 0; i < iterations + 1; ++i) {
+        stages.push_back(UsdStage::CreateInMemory());
+    }
+
+    // The first broker discovers dispatchers from plugins.
+    auto start = std::chrono::steady_clock::now();
+    unf::Broker::Create(stages[0]);
+    auto end = std::chrono::steady_clock::now();
+
+    const double first =
+        std::chrono::duration<double, std::micro>(end - start).count();
+
+    double total = 0;
+    double best = 0;
+
+    for (int i = 0; i < iterations; ++i) {
+        start = std::chrono::steady_clock::now();
+        unf::Broker::Create(stages[i + 1]);
+        end = std::chrono::steady_clock::now();
+
+        const double elapsed =
+            std::chrono::duration<double, std::micro>(end - start).count();
+
+        total += elapsed;
+        best = (i == 0) ? elapsed : std::min(best, elapsed);
+    }
+
+    std::printf("first broker: %.3f us\n", first);
+    std::printf(
+        "%d brokers: mean %.3f us, best %.3f us\n",
+        iterations,
+        total / iterations,
+        best);
+
+    unf::Broker::ResetAll();
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Replay a notice recording through a broker attached to an in-memory stage
+// and report the time spent per iteration.
+//
+// Usage: unfReplay <recording> [iterations] [listeners]
+
+#include <unf/broker.h>
+#include <unf/notice.h>
+#include <unf/recorder.h>
+
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/base/tf/weakPtr.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/usd/common.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+// Listener counting all standalone notices received.
+class Listener : public TfWeakBase {
+  public:
+    Listener(const UsdStageWeakPtr& stage)
+    {
+        _key = TfNotice::Register(
+            TfCreateWeakPtr(this), &Listener::OnReceiving, stage);
+    }
+
+    ~Listener() { TfNotice::Revoke(_key); }
+
+    void OnReceiving(
+        const unf::UnfNotice::StageNotice&, const UsdStageWeakPtr&)
+    {
+        _count++;
+    }
+
+    size_t Received() const { return _count; }
+
+  private:
+    TfNotice::Key _key;
+    size_t _count = 0;
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::fprintf(
+            stderr,
+            "Usage: %s <recording> [iterations] [listeners]\n",
+            argv[0]);
+        return 1;
+    }
+
+    const int iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 10;
+    const int listenerCount = argc > 3 ? std::max(std::atoi(argv[3]), 0) : 1;
+
+    unf::NoticeRecording recording(argv[1]);
+    if (!recording.IsValid()) return 1;
+
+    std::printf(
+        "%zu events, %zu notices\n",
+        recording.GetEventCount(),
+        recording.GetNoticeCount());
+
+    auto stage = UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    std::vector<std::unique_ptr<Listener> > listeners;
+    for (int i = 0; i < listenerCount; ++i) {
+        listeners.push_back(std::make_unique<Listener>(stage));
+    }
+
+    double total = 0;
+    double best = 0;
+
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        recording.Replay(broker);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double elapsed =
+            std::chrono::duration<double, std::milli>(end - start).count();
+
+        total += elapsed;
+        best = (i == 0) ? elapsed : std::min(best, elapsed);
+    }
+
+    std::printf(
+        "%d iterations: mean %.3f ms, best %.3f ms\n",
+        iterations,
+        total / iterations,
+        best);
+
+    if (!listeners.empty()) {
+        std::printf(
+            "%zu notices received per listener\n",
+            listeners.front()->Received() / iterations);
+    }
+
+    return 0;
+}
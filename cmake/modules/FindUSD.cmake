@@ -3,6 +3,7 @@
 # This module defines the following imported targets:
 #     usd::usd
 #     usd::sdf
+#     usd::pcp
 #     usd::tf
 #     usd::plug
 #     usd::arch
@@ -38,7 +39,7 @@ find_path(
         include
 )
 
-set(USD_LIBRARIES usd sdf tf plug arch vt boost python)
+set(USD_LIBRARIES usd sdf pcp tf plug arch vt boost python)
 
 mark_as_advanced(USD_INCLUDE_DIR USD_LIBRARIES)
 
@@ -90,6 +91,7 @@ find_package_handle_standard_args(
         USD_INCLUDE_DIR
         usd_LIBRARY
         sdf_LIBRARY
+        pcp_LIBRARY
         tf_LIBRARY
         plug_LIBRARY
         arch_LIBRARY
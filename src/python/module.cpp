@@ -6,4 +6,7 @@ TF_WRAP_MODULE
     TF_WRAP(Broker);
     TF_WRAP(Notice);
     TF_WRAP(Transaction);
+    TF_WRAP(MultiTransaction);
+    TF_WRAP(LayerDiff);
+    TF_WRAP(ChangeTracker);
 }
@@ -0,0 +1,217 @@
+#ifndef USD_NOTICE_FRAMEWORK_PYTHON_SEQUENCE_H
+#define USD_NOTICE_FRAMEWORK_PYTHON_SEQUENCE_H
+
+#include <pxr/pxr.h>
+
+#include <pxr/external/boost/python.hpp>
+using namespace PXR_BOOST_PYTHON_NAMESPACE;
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+// Read-only Python sequence referencing a container owned by a notice.
+//
+// The view does not copy the container. Functions returning a view must use
+// the 'with_custodian_and_ward_postcall' policy so that the notice is kept
+// alive as long as the view.
+template <class Container>
+class SequenceView {
+  public:
+    using value_type = typename Container::value_type;
+    using const_iterator = typename Container::const_iterator;
+
+    SequenceView() = default;
+    explicit SequenceView(const Container* data) : _data(data) {}
+
+    size_t size() const { return _data ? _data->size() : 0; }
+
+    const_iterator begin() const { return _Get().begin(); }
+    const_iterator end() const { return _Get().end(); }
+
+    value_type GetItem(long index) const
+    {
+        const long _size = static_cast<long>(size());
+        if (index < 0) index += _size;
+
+        if (index < 0 || index >= _size) {
+            PyErr_SetString(PyExc_IndexError, "index out of range");
+            throw_error_already_set();
+        }
+
+        return *std::next(begin(), index);
+    }
+
+    bool Contains(const value_type& value) const
+    {
+        // Paths are usually held in lexicographical order, so they can be
+        // searched by bisection.
+        if (_IsSorted()) return std::binary_search(begin(), end(), value);
+        return std::find(begin(), end(), value) != end();
+    }
+
+  private:
+    const Container& _Get() const
+    {
+        static const Container empty;
+        return _data ? *_data : empty;
+    }
+
+    // Order is checked once per view, as merged notices might hold paths
+    // which are not sorted.
+    bool _IsSorted() const
+    {
+        if (_sorted < 0) _sorted = std::is_sorted(begin(), end()) ? 1 : 0;
+        return _sorted == 1;
+    }
+
+    const Container* _data = nullptr;
+    mutable int _sorted = -1;
+};
+
+// Read-only Python set referencing an unordered container owned by a notice.
+//
+// Elements cannot be accessed by index, as the container is not ordered.
+template <class Container>
+class SetView {
+  public:
+    using value_type = typename Container::value_type;
+    using hasher = typename Container::hasher;
+    using const_iterator = typename Container::const_iterator;
+
+    SetView() = default;
+    explicit SetView(const Container* data) : _data(data) {}
+
+    size_t size() const { return _data ? _data->size() : 0; }
+
+    const_iterator begin() const { return _Get().begin(); }
+    const_iterator end() const { return _Get().end(); }
+
+    bool Contains(const value_type& value) const
+    {
+        return _Get().find(value) != end();
+    }
+
+  private:
+    const Container& _Get() const
+    {
+        static const Container empty;
+        return _data ? *_data : empty;
+    }
+
+    const Container* _data = nullptr;
+};
+
+template <class View>
+bool SequenceView_Equal(const View& self, object other)
+{
+    if (!PySequence_Check(other.ptr())) return false;
+    if (static_cast<size_t>(len(other)) != self.size()) return false;
+
+    long index = 0;
+    for (const auto& value : self) {
+        if (object(value) != other[index++]) return false;
+    }
+    return true;
+}
+
+template <class View>
+bool SequenceView_NotEqual(const View& self, object other)
+{
+    return !SequenceView_Equal(self, other);
+}
+
+template <class View>
+bool SetView_Equal(const View& self, object other)
+{
+    if (!PySequence_Check(other.ptr()) && !PyAnySet_Check(other.ptr())) {
+        return false;
+    }
+
+    // Elements are compared regardless of their order.
+    std::unordered_set<typename View::value_type, typename View::hasher>
+        values;
+    const list _other(other);
+    for (long index = 0; index < len(_other); ++index) {
+        extract<typename View::value_type> value(_other[index]);
+        if (!value.check()) return false;
+        values.insert(value());
+    }
+
+    if (values.size() != self.size()) return false;
+    for (const auto& value : values) {
+        if (!self.Contains(value)) return false;
+    }
+    return true;
+}
+
+template <class View>
+bool SetView_NotEqual(const View& self, object other)
+{
+    return !SetView_Equal(self, other);
+}
+
+template <class View>
+std::string SequenceView_Repr(const View& self)
+{
+    std::string result = "[";
+    for (const auto& value : self) {
+        if (result.size() > 1) result += ", ";
+        result += extract<std::string>(object(value).attr("__repr__")())();
+    }
+    return result + "]";
+}
+
+template <class Container>
+void WrapSequenceView(const char* name)
+{
+    using View = SequenceView<Container>;
+
+    class_<View>(
+        name,
+        "Read-only sequence referencing data owned by a notice.",
+        no_init)
+
+        .def("__len__", &View::size)
+
+        .def("__getitem__", &View::GetItem)
+
+        .def("__contains__", &View::Contains)
+
+        .def("__iter__", range(&View::begin, &View::end))
+
+        .def("__eq__", &SequenceView_Equal<View>)
+
+        .def("__ne__", &SequenceView_NotEqual<View>)
+
+        .def("__repr__", &SequenceView_Repr<View>);
+}
+
+template <class Container>
+void WrapSetView(const char* name)
+{
+    using View = SetView<Container>;
+
+    class_<View>(
+        name,
+        "Read-only set referencing data owned by a notice.",
+        no_init)
+
+        .def("__len__", &View::size)
+
+        .def("__contains__", &View::Contains)
+
+        .def("__iter__", range(&View::begin, &View::end))
+
+        .def("__eq__", &SetView_Equal<View>)
+
+        .def("__ne__", &SetView_NotEqual<View>)
+
+        .def("__repr__", &SequenceView_Repr<View>);
+}
+
+#endif  // USD_NOTICE_FRAMEWORK_PYTHON_SEQUENCE_H
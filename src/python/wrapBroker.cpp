@@ -7,12 +7,20 @@
 
 #include <pxr/base/tf/makePyConstructor.h>
 #include <pxr/base/tf/pyFunction.h>
+#include <pxr/base/tf/pyCall.h>
+#include <pxr/base/tf/pyLock.h>
+#include <pxr/base/tf/pyNoticeWrapper.h>
+#include <pxr/base/tf/pyObjWrapper.h>
 #include <pxr/base/tf/pyPtrHelpers.h>
+#include <pxr/base/tf/type.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <chrono>
+#include <cstdint>
+
 #include <pxr/external/boost/python.hpp>
 using namespace PXR_BOOST_PYTHON_NAMESPACE;
 using noncopyable = PXR_BOOST_PYTHON_NAMESPACE::noncopyable;
@@ -27,12 +35,175 @@ void Broker_BeginTransaction_WithFunc(Broker& self, object predicate)
     self.BeginTransaction(_predicate);
 }
 
+void Broker_EndTransaction(Broker& self)
+{
+    // Release the GIL while notices are merged and sent. It is acquired
+    // again by Python predicates and listeners.
+    TfPyAllowThreadsInScope allowThreads;
+    self.EndTransaction();
+}
+
+size_t Broker_PumpNoticesFor(Broker& self, double milliseconds)
+{
+    const auto budget = std::chrono::duration<double, std::milli>(milliseconds);
+    return self.PumpNoticesFor(
+        std::chrono::duration_cast<std::chrono::microseconds>(budget));
+}
+
+// Return type from a Tf.Type instance or a notice class.
+TfType _GetNoticeType(object type)
+{
+    extract<TfType> _type(type);
+    if (_type.check()) return _type();
+
+    return TfType::FindByPythonClass(type);
+}
+
+void Broker_RequestNotices(Broker& self, object type)
+{
+    self.RequestNotices(_GetNoticeType(type));
+}
+
+void Broker_ReleaseNotices(Broker& self, object type)
+{
+    self.ReleaseNotices(_GetNoticeType(type));
+}
+
+bool Broker_IsRequested(Broker& self, object type)
+{
+    return self.IsRequested(_GetNoticeType(type));
+}
+
+Subscription* Broker_Subscribe(Broker& self, object type, object callback)
+{
+    TfPyCall<void> _callback{TfPyObjWrapper(callback)};
+
+    return new Subscription(self.Subscribe(
+        _GetNoticeType(type),
+        [_callback](const unf::UnfNotice::StageNotice& notice) {
+            TfPyLock lock;
+            _callback(Tf_PyNoticeObjectGenerator::Invoke(notice));
+        }));
+}
+
+JournalChanges Broker_GetJournalChanges(Broker& self, uint64_t sequence)
+{
+    // Release the GIL while notices are merged.
+    TfPyAllowThreadsInScope allowThreads;
+    return self.GetJournalChanges(sequence);
+}
+
+JournalChanges JournalCursor_Fetch(JournalCursor& self)
+{
+    // Release the GIL while notices are merged.
+    TfPyAllowThreadsInScope allowThreads;
+    return self.Fetch();
+}
+
+object JournalChanges_GetNotice(const JournalChanges& self)
+{
+    if (!self.notice) return object();
+    return Tf_PyNoticeObjectGenerator::Invoke(*self.notice);
+}
+
 void wrapBroker()
 {
     // Ensure that predicate function can be passed from Python.
     TfPyFunctionFromPython<_CapturePredicateFuncRaw>();
 
-    class_<Broker, BrokerWeakPtr, noncopyable>(
+    class_<CoarseningPolicy>(
+        "CoarseningPolicy",
+        "Policy defining how ObjectsChanged notices are coarsened to bound "
+        "the number of paths that listeners need to process.")
+
+        .def_readwrite(
+            "maxChildren",
+            &CoarseningPolicy::maxChildren,
+            "Maximum number of changed children per prim.")
+
+        .def_readwrite(
+            "maxPaths",
+            &CoarseningPolicy::maxPaths,
+            "Maximum number of paths held by the notice.")
+
+        .def_readwrite(
+            "collapseToRoot",
+            &CoarseningPolicy::collapseToRoot,
+            "Indicate whether changes can be collapsed into a resync of the "
+            "pseudo-root.")
+
+        .def(
+            "IsEnabled",
+            &CoarseningPolicy::IsEnabled,
+            "Indicate whether the policy can coarsen notices.");
+
+    class_<Subscription, noncopyable>(
+        "Subscription",
+        "Handle to a callback registered with Broker.Subscribe.",
+        no_init)
+
+        .def(
+            "IsActive",
+            &Subscription::IsActive,
+            "Indicate whether the callback is still registered.")
+
+        .def(
+            "Reset",
+            &Subscription::Reset,
+            "Unregister callback.");
+
+    class_<JournalChanges>(
+        "JournalChanges",
+        "Changes recorded by the journal of a Broker since a sequence number.",
+        no_init)
+
+        .def_readonly(
+            "sequence",
+            &JournalChanges::sequence,
+            "Sequence number of the latest emission included.")
+
+        .def_readonly(
+            "resyncAll",
+            &JournalChanges::resyncAll,
+            "Indicate whether emissions requested were dropped from the "
+            "journal.")
+
+        .add_property(
+            "notice",
+            &JournalChanges_GetNotice,
+            "Notice holding all notices recorded since the sequence number "
+            "requested, or None.");
+
+    class_<JournalCursor>(
+        "JournalCursor",
+        "Position of a consumer polling the journal of a Broker.",
+        no_init)
+
+        .def(init<const BrokerWeakPtr&>(
+            arg("broker"),
+            "Create cursor positioned at the latest emission recorded."))
+
+        .def(init<const BrokerWeakPtr&, uint64_t>(
+            (arg("broker"), arg("sequence")),
+            "Create cursor positioned at sequence."))
+
+        .def(
+            "GetSequence",
+            &JournalCursor::GetSequence,
+            "Return sequence number of the latest emission fetched.")
+
+        .def(
+            "HasChanges",
+            &JournalCursor::HasChanges,
+            "Indicate whether emissions were recorded since the latest fetch.")
+
+        .def(
+            "Fetch",
+            &JournalCursor_Fetch,
+            "Return changes recorded since the latest fetch, and move the "
+            "cursor to the latest emission recorded.");
+
+    scope broker = class_<Broker, BrokerWeakPtr, noncopyable>(
         "Broker",
         "Intermediate object between the Usd Stage and any clients that needs "
         "asynchronous handling and upstream filtering of notices.",
@@ -73,6 +244,148 @@ void wrapBroker()
 
         .def(
             "EndTransaction",
-            &Broker::EndTransaction,
-            "Stop a notice transaction.");
+            &Broker_EndTransaction,
+            "Stop a notice transaction.")
+
+        .def(
+            "SetChunkedDelivery",
+            &Broker::SetChunkedDelivery,
+            arg("size"),
+            "Split large ObjectsChanged notices into chunks of at most 'size' "
+            "paths which are delivered with PumpNotices.")
+
+        .def(
+            "GetChunkedDeliverySize",
+            &Broker::GetChunkedDeliverySize,
+            "Return maximum number of paths per chunk, or zero if chunked "
+            "delivery is disabled.")
+
+        .def(
+            "HasPendingNotices",
+            &Broker::HasPendingNotices,
+            "Indicate whether chunks are waiting to be delivered.")
+
+        .def(
+            "PumpNotices",
+            &Broker::PumpNotices,
+            (arg("count") = 1),
+            "Emit up to 'count' pending chunks.")
+
+        .def(
+            "PumpNoticesFor",
+            &Broker_PumpNoticesFor,
+            ((arg("self"), arg("milliseconds"))),
+            "Emit pending chunks until the time budget is exceeded.")
+
+        .def(
+            "FlushNotices",
+            &Broker::FlushNotices,
+            "Emit all pending chunks.")
+
+        .def(
+            "GetMemoryUsage",
+            &Broker::GetMemoryUsage,
+            "Return an estimate of the memory held by the broker in bytes.")
+
+        .def(
+            "SetCoarseningPolicy",
+            &Broker::SetCoarseningPolicy,
+            arg("policy"),
+            "Set policy used to coarsen ObjectsChanged notices when a "
+            "transaction ends.")
+
+        .def(
+            "GetCoarseningPolicy",
+            &Broker::GetCoarseningPolicy,
+            return_value_policy<copy_const_reference>(),
+            "Return policy used to coarsen notices.")
+
+        .def(
+            "Subscribe",
+            &Broker_Subscribe,
+            ((arg("self"), arg("type"), arg("callback"))),
+            "Register callback invoked with each notice of 'type' emitted by "
+            "the broker.",
+            return_value_policy<manage_new_object>())
+
+        .def(
+            "SetTfNoticeDelivery",
+            &Broker::SetTfNoticeDelivery,
+            arg("enabled"),
+            "Indicate whether notices emitted should be sent via "
+            "Tf.Notice.")
+
+        .def(
+            "IsTfNoticeDeliveryEnabled",
+            &Broker::IsTfNoticeDeliveryEnabled,
+            "Indicate whether TfNotice delivery is enabled.")
+
+        .def(
+            "SetCommitDelivery",
+            &Broker::SetCommitDelivery,
+            arg("delivery"),
+            "Set how consolidated notices are emitted when the outermost "
+            "transaction ends.")
+
+        .def(
+            "GetCommitDelivery",
+            &Broker::GetCommitDelivery,
+            "Return how consolidated notices are emitted.")
+
+        .def(
+            "SetJournalCapacity",
+            &Broker::SetJournalCapacity,
+            ((arg("self"), arg("capacity"))),
+            "Set maximum number of emissions recorded by the journal.")
+
+        .def(
+            "GetJournalCapacity",
+            &Broker::GetJournalCapacity,
+            "Return maximum number of emissions recorded by the journal.")
+
+        .def(
+            "GetJournalSequence",
+            &Broker::GetJournalSequence,
+            "Return sequence number of the latest emission.")
+
+        .def(
+            "GetJournalChanges",
+            &Broker_GetJournalChanges,
+            ((arg("self"), arg("sequence"))),
+            "Return changes emitted after sequence.")
+
+        .def(
+            "SetLazyRegistration",
+            &Broker::SetLazyRegistration,
+            arg("enabled"),
+            "Indicate whether dispatchers should only listen to incoming "
+            "notices when the notices they emit are requested.")
+
+        .def(
+            "IsLazyRegistrationEnabled",
+            &Broker::IsLazyRegistrationEnabled,
+            "Indicate whether lazy registration is enabled.")
+
+        .def(
+            "RequestNotices",
+            &Broker_RequestNotices,
+            ((arg("self"), arg("type"))),
+            "Request notices of 'type' and derived types.")
+
+        .def(
+            "ReleaseNotices",
+            &Broker_ReleaseNotices,
+            ((arg("self"), arg("type"))),
+            "Release notices of 'type' requested with RequestNotices.")
+
+        .def(
+            "IsRequested",
+            &Broker_IsRequested,
+            ((arg("self"), arg("type"))),
+            "Indicate whether notices of 'type' should be emitted.");
+
+    enum_<Broker::CommitDelivery>("CommitDelivery")
+        .value("Separate", Broker::CommitDelivery::Separate)
+        .value("Composite", Broker::CommitDelivery::Composite)
+        .value("Both", Broker::CommitDelivery::Both);
 }
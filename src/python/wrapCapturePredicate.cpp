@@ -4,6 +4,13 @@
 
 #include "unf/capturePredicate.h"
 
+#include <pxr/base/tf/token.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <vector>
+
 #include <pxr/external/boost/python.hpp>
 using namespace PXR_BOOST_PYTHON_NAMESPACE;
 
@@ -11,6 +18,31 @@ using namespace unf;
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
+// Return types from a list of Tf.Type instances or notice classes.
+std::vector<TfType> _GetTypes(object types)
+{
+    std::vector<TfType> _types;
+
+    for (long i = 0; i < len(types); ++i) {
+        object type = types[i];
+
+        extract<TfType> _type(type);
+        _types.push_back(
+            _type.check() ? _type() : TfType::FindByPythonClass(type));
+    }
+
+    return _types;
+}
+
+CapturePredicate CapturePredicate_AllowTypes(object types)
+{
+    return CapturePredicate::AllowTypes(_GetTypes(types));
+}
+
+CapturePredicate CapturePredicate_BlockTypes(object types)
+{
+    return CapturePredicate::BlockTypes(_GetTypes(types));
+}
 
 void wrapCapturePredicate()
 {
@@ -30,5 +62,30 @@ void wrapCapturePredicate()
             "BlockAll",
             &CapturePredicate::BlockAll,
             "Create a predicate which return false for each notice type.")
-        .staticmethod("BlockAll");
+        .staticmethod("BlockAll")
+
+        .def(
+            "AllowTypes",
+            &CapturePredicate_AllowTypes,
+            arg("types"),
+            "Create a predicate which only return true for notices derived "
+            "from one of 'types'.")
+        .staticmethod("AllowTypes")
+
+        .def(
+            "BlockTypes",
+            &CapturePredicate_BlockTypes,
+            arg("types"),
+            "Create a predicate which return false for notices derived from "
+            "one of 'types'.")
+        .staticmethod("BlockTypes")
+
+        .def(
+            "Trimming",
+            &CapturePredicate::Trimming,
+            (arg("subtrees"), arg("ignoredFields")),
+            "Create a predicate which captures all notices, but removes paths "
+            "outside of 'subtrees' and fields within 'ignoredFields' from "
+            "ObjectsChanged notices.")
+        .staticmethod("Trimming");
 }
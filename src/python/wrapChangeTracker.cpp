@@ -0,0 +1,51 @@
+// clang-format off
+
+#include "unf/broker.h"
+#include "unf/changeTracker.h"
+
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <pxr/external/boost/python.hpp>
+using namespace PXR_BOOST_PYTHON_NAMESPACE;
+
+using namespace unf;
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using noncopyable = PXR_BOOST_PYTHON_NAMESPACE::noncopyable;
+
+void wrapChangeTracker()
+{
+    class_<ChangeTracker, noncopyable>(
+        "ChangeTracker",
+        "Record generation at which each path was changed, so that caches "
+        "can query whether a path changed since they last looked.",
+        no_init)
+
+        .def(init<const BrokerWeakPtr&>(
+            arg("broker"),
+            "Start tracking changes emitted by broker."))
+
+        .def(
+            "GetGeneration",
+            &ChangeTracker::GetGeneration,
+            "Return current generation.")
+
+        .def(
+            "ChangedSince",
+            &ChangeTracker::ChangedSince,
+            (arg("path"), arg("generation")),
+            "Indicate whether path changed after generation.")
+
+        .def(
+            "Compact",
+            &ChangeTracker::Compact,
+            arg("generation"),
+            "Discard stamps which are not more recent than generation.")
+
+        .def(
+            "GetSize",
+            &ChangeTracker::GetSize,
+            "Return number of paths recorded, including their ancestors.");
+}
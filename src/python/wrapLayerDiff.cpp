@@ -0,0 +1,73 @@
+// clang-format off
+
+#include "unf/broker.h"
+#include "unf/layerDiff.h"
+
+#include <pxr/base/tf/pyLock.h>
+#include <pxr/base/tf/pyResultConversions.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/layer.h>
+
+#include <pxr/external/boost/python.hpp>
+using namespace PXR_BOOST_PYTHON_NAMESPACE;
+
+using namespace unf;
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+bool _ReloadLayer(
+    const BrokerWeakPtr& broker, const SdfLayerHandle& layer, bool force)
+{
+    // Release the GIL while the layer is compared. It is acquired again by
+    // Python listeners.
+    TfPyAllowThreadsInScope allowThreads;
+    return ReloadLayer(broker, layer, force);
+}
+
+void _ReplaceLayerContent(
+    const BrokerWeakPtr& broker,
+    const SdfLayerHandle& layer,
+    const SdfLayerHandle& source)
+{
+    TfPyAllowThreadsInScope allowThreads;
+    ReplaceLayerContent(broker, layer, source);
+}
+
+void wrapLayerDiff()
+{
+    class_<LayerDiff>(
+        "LayerDiff",
+        "Compare the content of two layers spec by spec.",
+        init<const SdfLayerHandle&, const SdfLayerHandle&>(
+            (arg("before"), arg("after"))))
+
+        .def(
+            "IsEmpty",
+            &LayerDiff::IsEmpty,
+            "Indicate whether both layers have the same content.")
+
+        .def(
+            "GetResyncedPaths",
+            &LayerDiff::GetResyncedPaths,
+            "Return list of paths that are resynced in lexicographical order.",
+            return_value_policy<TfPySequenceToList>())
+
+        .def(
+            "GetChangedInfoOnlyPaths",
+            &LayerDiff::GetChangedInfoOnlyPaths,
+            "Return list of paths that are modified but not resynced in "
+            "lexicographical order.",
+            return_value_policy<TfPySequenceToList>());
+
+    def("ReloadLayer",
+        &_ReloadLayer,
+        (arg("broker"), arg("layer"), arg("force") = false),
+        "Reload layer and emit a fine-grained ObjectsChanged notice via the "
+        "broker.");
+
+    def("ReplaceLayerContent",
+        &_ReplaceLayerContent,
+        (arg("broker"), arg("layer"), arg("source")),
+        "Replace the content of layer with the content of source and emit a "
+        "fine-grained ObjectsChanged notice via the broker.");
+}
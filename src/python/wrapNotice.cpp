@@ -1,13 +1,20 @@
 // clang-format off
 
+#include "./sequence.h"
+
 #include "unf/notice.h"
 
 #include <pxr/base/tf/notice.h>
 #include <pxr/base/tf/pyContainerConversions.h>
+#include <pxr/base/tf/pyLock.h>
 #include <pxr/base/tf/pyNoticeWrapper.h>
 #include <pxr/base/tf/pyResultConversions.h>
 
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/object.h>
+
+#include <vector>
 
 #include <pxr/external/boost/python.hpp>
 using namespace PXR_BOOST_PYTHON_NAMESPACE;
@@ -23,6 +30,143 @@ TF_INSTANTIATE_NOTICE_WRAPPER(StageContentsChanged, StageNotice);
 TF_INSTANTIATE_NOTICE_WRAPPER(ObjectsChanged, StageNotice);
 TF_INSTANTIATE_NOTICE_WRAPPER(StageEditTargetChanged, StageNotice);
 TF_INSTANTIATE_NOTICE_WRAPPER(LayerMutingChanged, StageNotice);
+TF_INSTANTIATE_NOTICE_WRAPPER(LayersChanged, StageNotice);
+TF_INSTANTIATE_NOTICE_WRAPPER(TransactionCommitted, StageNotice);
+
+using PathSequenceView = SequenceView<SdfPathVector>;
+using TokenSetView = SetView<unf::TfTokenSet>;
+
+// Policy used to keep the notice alive as long as the view returned.
+using ViewPolicy = with_custodian_and_ward_postcall<0, 1>;
+
+PathSequenceView ObjectsChanged_GetResyncedPaths(const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetResyncedPaths());
+}
+
+PathSequenceView ObjectsChanged_GetChangedInfoOnlyPaths(
+    const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetChangedInfoOnlyPaths());
+}
+
+PathSequenceView ObjectsChanged_GetResyncedPrimPaths(
+    const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetResyncedPrimPaths());
+}
+
+PathSequenceView ObjectsChanged_GetValueChangedPrimPaths(
+    const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetValueChangedPrimPaths());
+}
+
+PathSequenceView ObjectsChanged_GetMetadataChangedPrimPaths(
+    const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetMetadataChangedPrimPaths());
+}
+
+PathSequenceView ObjectsChanged_GetAffectedPrimPaths(
+    const ObjectsChanged& self)
+{
+    return PathSequenceView(&self.GetAffectedPrimPaths());
+}
+
+TokenSetView ObjectsChanged_GetChangedFields(
+    const ObjectsChanged& self, const SdfPath& path)
+{
+    const auto& fieldMap = self.GetChangedFieldMap();
+    const auto it = fieldMap.find(path);
+    if (it == fieldMap.end()) return TokenSetView();
+    return TokenSetView(&it->second);
+}
+
+TokenSetView ObjectsChanged_GetChangedFieldsFromObject(
+    const ObjectsChanged& self, const UsdObject& usdObject)
+{
+    return ObjectsChanged_GetChangedFields(self, usdObject.GetPath());
+}
+
+list _ToList(const std::vector<bool>& values)
+{
+    list result;
+    for (bool value : values) {
+        result.append(value);
+    }
+    return result;
+}
+
+// Run batch query on notice without holding the GIL.
+template <class Result>
+Result _Query(
+    const ObjectsChanged& self,
+    const SdfPathVector& paths,
+    Result (ObjectsChanged::*method)(const SdfPathVector&) const)
+{
+    TfPyAllowThreadsInScope allowThreads;
+    return (self.*method)(paths);
+}
+
+list ObjectsChanged_QueryResynced(
+    const ObjectsChanged& self, const SdfPathVector& paths)
+{
+    return _ToList(_Query(self, paths, &ObjectsChanged::QueryResynced));
+}
+
+list ObjectsChanged_QueryChangedInfoOnly(
+    const ObjectsChanged& self, const SdfPathVector& paths)
+{
+    return _ToList(
+        _Query(self, paths, &ObjectsChanged::QueryChangedInfoOnly));
+}
+
+list ObjectsChanged_QueryAffected(
+    const ObjectsChanged& self, const SdfPathVector& paths)
+{
+    return _ToList(_Query(self, paths, &ObjectsChanged::QueryAffected));
+}
+
+list ObjectsChanged_QueryChangeCategories(
+    const ObjectsChanged& self, const SdfPathVector& paths)
+{
+    const auto categories =
+        _Query(self, paths, &ObjectsChanged::QueryChangeCategories);
+
+    list result;
+    for (const auto category : categories) {
+        result.append(static_cast<unsigned int>(category));
+    }
+    return result;
+}
+
+unsigned int ObjectsChanged_GetChangeCategories(const ObjectsChanged& self)
+{
+    return static_cast<unsigned int>(self.GetChangeCategories());
+}
+
+unsigned int ObjectsChanged_GetChangeCategoriesFromPath(
+    const ObjectsChanged& self, const SdfPath& path)
+{
+    return static_cast<unsigned int>(self.GetChangeCategories(path));
+}
+
+list ObjectsChanged_QueryHasChangedFields(
+    const ObjectsChanged& self, const SdfPathVector& paths)
+{
+    return _ToList(
+        _Query(self, paths, &ObjectsChanged::QueryHasChangedFields));
+}
+
+list TransactionCommitted_GetNotices(const TransactionCommitted& self)
+{
+    list result;
+    for (const auto& notice : self.GetNotices()) {
+        result.append(Tf_PyNoticeObjectGenerator::Invoke(*notice));
+    }
+    return result;
+}
 
 }  // anonymous namespace
 
@@ -31,6 +175,76 @@ class PythonUnfNotice {};
 
 void wrapNotice()
 {
+    WrapSequenceView<SdfPathVector>("PathSequenceView");
+    WrapSetView<unf::TfTokenSet>("TokenSetView");
+
+    {
+        scope policy = class_<unf::MergePolicy>(
+            "MergePolicy",
+            "Policy defining how notices of the same type are consolidated "
+            "during a transaction.",
+            no_init)
+
+            .def(
+                "Merge",
+                &unf::MergePolicy::Merge,
+                "Create a policy which merges all notices into the first one.")
+            .staticmethod("Merge")
+
+            .def(
+                "KeepAll",
+                &unf::MergePolicy::KeepAll,
+                "Create a policy which keeps all notices.")
+            .staticmethod("KeepAll")
+
+            .def(
+                "KeepLatest",
+                &unf::MergePolicy::KeepLatest,
+                "Create a policy which keeps the latest notice only.")
+            .staticmethod("KeepLatest")
+
+            .def(
+                "KeepFirstAndLast",
+                &unf::MergePolicy::KeepFirstAndLast,
+                "Create a policy which keeps the first and the latest notices "
+                "only.")
+            .staticmethod("KeepFirstAndLast")
+
+            .def(
+                "BoundedRing",
+                &unf::MergePolicy::BoundedRing,
+                arg("capacity"),
+                "Create a policy which keeps a bounded number of the latest "
+                "notices.")
+            .staticmethod("BoundedRing")
+
+            .def(
+                "GetMode",
+                &unf::MergePolicy::GetMode,
+                "Return consolidation mode.")
+
+            .def(
+                "GetCapacity",
+                &unf::MergePolicy::GetCapacity,
+                "Return maximum number of notices kept per transaction, or "
+                "zero if the number of notices is not bounded.");
+
+        enum_<unf::MergePolicy::Mode>("Mode")
+            .value("Merge", unf::MergePolicy::Mode::Merge)
+            .value("KeepAll", unf::MergePolicy::Mode::KeepAll)
+            .value("KeepLatest", unf::MergePolicy::Mode::KeepLatest)
+            .value(
+                "KeepFirstAndLast", unf::MergePolicy::Mode::KeepFirstAndLast)
+            .value("BoundedRing", unf::MergePolicy::Mode::BoundedRing);
+    }
+
+    enum_<unf::ChangeCategory>("ChangeCategory")
+        .value("Structure", unf::ChangeCategory::Structure)
+        .value("ResolvedAssetPath", unf::ChangeCategory::ResolvedAssetPath)
+        .value("Value", unf::ChangeCategory::Value)
+        .value("TimeSamples", unf::ChangeCategory::TimeSamples)
+        .value("Metadata", unf::ChangeCategory::Metadata);
+
     scope s = class_<PythonUnfNotice>(
         "Notice",
         "Regroup all standalone notices used by the library.",
@@ -43,10 +257,21 @@ void wrapNotice()
             "Indicate whether notice from the same type can be consolidated "
             "during a transaction")
 
+        .def(
+            "GetMergePolicy",
+            &StageNotice::GetMergePolicy,
+            "Return policy defining how notices from the same type are "
+            "consolidated during a transaction")
+
         .def(
             "GetTypeId",
             &StageNotice::GetTypeId,
-            "Return unique type identifier");
+            "Return unique type identifier")
+
+        .def(
+            "GetMemoryUsage",
+            &StageNotice::GetMemoryUsage,
+            "Return an estimate of the memory held by the notice in bytes");
 
     TfPyNoticeWrapper<StageContentsChanged, StageNotice>::Wrap();
 
@@ -71,32 +296,31 @@ void wrapNotice()
 
         .def(
             "GetResyncedPaths",
-            &ObjectsChanged::GetResyncedPaths,
-            "Return list of paths that are resynced in lexicographical order.",
-            return_value_policy<return_by_value>())
+            &ObjectsChanged_GetResyncedPaths,
+            "Return sequence of paths that are resynced in lexicographical "
+            "order.",
+            ViewPolicy())
 
         .def(
             "GetChangedInfoOnlyPaths",
-            &ObjectsChanged::GetChangedInfoOnlyPaths,
-            "Return list of paths that are modified but not resynced in "
+            &ObjectsChanged_GetChangedInfoOnlyPaths,
+            "Return sequence of paths that are modified but not resynced in "
             "lexicographical order.",
-            return_value_policy<return_by_value>())
+            ViewPolicy())
 
         .def(
             "GetChangedFields",
-            (unf::TfTokenSet(ObjectsChanged::*)(const SdfPath&) const)
-                & ObjectsChanged::GetChangedFields,
-            "Return the list of changed fields in layers that affected the "
-            "path",
-            return_value_policy<TfPySequenceToList>())
+            &ObjectsChanged_GetChangedFields,
+            "Return the sequence of changed fields in layers that affected "
+            "the path",
+            ViewPolicy())
 
         .def(
             "GetChangedFields",
-            (unf::TfTokenSet(ObjectsChanged::*)(const UsdObject&) const)
-                & ObjectsChanged::GetChangedFields,
-            "Return the list of changed fields in layers that affected the "
-            "object",
-            return_value_policy<TfPySequenceToList>())
+            &ObjectsChanged_GetChangedFieldsFromObject,
+            "Return the sequence of changed fields in layers that affected "
+            "the object",
+            ViewPolicy())
 
         .def(
             "HasChangedFields",
@@ -108,7 +332,89 @@ void wrapNotice()
             "HasChangedFields",
             (bool(ObjectsChanged::*)(const UsdObject&) const)
                 & ObjectsChanged::HasChangedFields,
-            "Indicate whether any changed fields affected the object");
+            "Indicate whether any changed fields affected the object")
+
+        .def(
+            "GetChangeCategories",
+            &ObjectsChanged_GetChangeCategories,
+            "Return categories of all changes held by the notice as "
+            "ChangeCategory flags.")
+
+        .def(
+            "GetChangeCategories",
+            &ObjectsChanged_GetChangeCategoriesFromPath,
+            arg("path"),
+            "Return categories of changes recorded on the path as "
+            "ChangeCategory flags.")
+
+        .def(
+            "GetResyncedPrimPaths",
+            &ObjectsChanged_GetResyncedPrimPaths,
+            "Return unique prim paths owning resynced paths in "
+            "lexicographical order.",
+            ViewPolicy())
+
+        .def(
+            "GetChangedPropertiesByPrim",
+            &ObjectsChanged::GetChangedPropertiesByPrim,
+            "Return resynced and modified property paths organized per "
+            "owning prim path.",
+            return_value_policy<TfPyMapToDictionary>())
+
+        .def(
+            "GetValueChangedPrimPaths",
+            &ObjectsChanged_GetValueChangedPrimPaths,
+            "Return prim paths for which only attribute values were "
+            "modified.",
+            ViewPolicy())
+
+        .def(
+            "GetMetadataChangedPrimPaths",
+            &ObjectsChanged_GetMetadataChangedPrimPaths,
+            "Return prim paths for which metadata were modified without "
+            "resync.",
+            ViewPolicy())
+
+        .def(
+            "GetAffectedPrimPaths",
+            &ObjectsChanged_GetAffectedPrimPaths,
+            "Return unique prim paths owning resynced or modified paths in "
+            "lexicographical order.",
+            ViewPolicy())
+
+        .def(
+            "IsCoarsened",
+            &ObjectsChanged::IsCoarsened,
+            "Indicate whether changes were replaced by resyncs of their "
+            "ancestors.")
+
+        .def(
+            "QueryResynced",
+            &ObjectsChanged_QueryResynced,
+            "Indicate for each path whether it or one of its ancestors was "
+            "resynced.")
+
+        .def(
+            "QueryChangedInfoOnly",
+            &ObjectsChanged_QueryChangedInfoOnly,
+            "Indicate for each path whether it or one of its ancestors was "
+            "modified but not resynced.")
+
+        .def(
+            "QueryAffected",
+            &ObjectsChanged_QueryAffected,
+            "Indicate for each path whether it was affected.")
+
+        .def(
+            "QueryHasChangedFields",
+            &ObjectsChanged_QueryHasChangedFields,
+            "Indicate for each path whether any changed fields affected it.")
+
+        .def(
+            "QueryChangeCategories",
+            &ObjectsChanged_QueryChangeCategories,
+            "Return for each path the categories of changes recorded on the "
+            "path or its ancestors as ChangeCategory flags.");
 
     TfPyNoticeWrapper<StageEditTargetChanged, StageNotice>::Wrap();
 
@@ -123,5 +429,47 @@ void wrapNotice()
             "GetUnmutedLayers",
             &LayerMutingChanged::GetUnmutedLayers,
             "Returns identifiers of the layers that were unmuted.",
-            return_value_policy<return_by_value>());
+            return_value_policy<return_by_value>())
+
+        .def(
+            "GetAffectedPrimPaths",
+            &LayerMutingChanged::GetAffectedPrimPaths,
+            "Return paths of prims whose composition includes one of the "
+            "muted or unmuted layers in lexicographical order.",
+            return_value_policy<TfPySequenceToList>());
+
+    TfPyNoticeWrapper<LayersChanged, StageNotice>::Wrap()
+        .def(
+            "GetLayers",
+            &LayersChanged::GetLayers,
+            "Return identifiers of the layers that were changed.",
+            return_value_policy<TfPySequenceToList>())
+
+        .def(
+            "GetChangedPaths",
+            &LayersChanged::GetChangedPaths,
+            arg("identifier"),
+            "Return list of spec paths that were changed in the layer in "
+            "lexicographical order.",
+            return_value_policy<TfPySequenceToList>())
+
+        .def(
+            "GetChangedFields",
+            &LayersChanged::GetChangedFields,
+            (arg("identifier"), arg("path")),
+            "Return the list of changed fields for the spec path in the layer.",
+            return_value_policy<TfPySequenceToList>())
+
+        .def(
+            "HasChangedFields",
+            &LayersChanged::HasChangedFields,
+            (arg("identifier"), arg("path")),
+            "Indicate whether any fields changed for the spec path in the "
+            "layer.");
+
+    TfPyNoticeWrapper<TransactionCommitted, StageNotice>::Wrap()
+        .def(
+            "GetNotices",
+            &TransactionCommitted_GetNotices,
+            "Return list of notices consolidated during the transaction.");
 }
@@ -7,10 +7,16 @@
 #include "unf/transaction.h"
 
 #include <pxr/base/tf/pyFunction.h>
+#include <pxr/base/tf/pyLock.h>
+#include <pxr/base/tf/pyResultConversions.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <pxr/external/boost/python.hpp>
 #include <pxr/external/boost/python/return_internal_reference.hpp>
 using namespace PXR_BOOST_PYTHON_NAMESPACE;
@@ -22,38 +28,46 @@ PXR_NAMESPACE_USING_DIRECTIVE
 // Expose C++ RAII class as python context manager.
 struct PythonNoticeTransaction {
     PythonNoticeTransaction(
-        const BrokerWeakPtr& broker, const _CapturePredicateFunc& func)
+        const BrokerWeakPtr& broker,
+        const _CapturePredicateFunc& func,
+        NoticeTransaction::Mode mode)
         : _func(func)
     {
         _makeContext = [=]() {
-            return new NoticeTransaction(broker, WrapPredicate(_func));
+            return new NoticeTransaction(broker, WrapPredicate(_func), mode);
         };
     }
 
     PythonNoticeTransaction(
-        const BrokerWeakPtr& broker, CapturePredicate predicate)
+        const BrokerWeakPtr& broker,
+        CapturePredicate predicate,
+        NoticeTransaction::Mode mode)
         : _predicate(predicate)
     {
         _makeContext = [=]() {
-            return new NoticeTransaction(broker, _predicate);
+            return new NoticeTransaction(broker, _predicate, mode);
         };
     }
 
     PythonNoticeTransaction(
-        const UsdStageWeakPtr& stage, const _CapturePredicateFunc& func)
+        const UsdStageWeakPtr& stage,
+        const _CapturePredicateFunc& func,
+        NoticeTransaction::Mode mode)
         : _func(func)
     {
         _makeContext = [=]() {
-            return new NoticeTransaction(stage, WrapPredicate(_func));
+            return new NoticeTransaction(stage, WrapPredicate(_func), mode);
         };
     }
 
     PythonNoticeTransaction(
-        const UsdStageWeakPtr& stage, CapturePredicate predicate)
+        const UsdStageWeakPtr& stage,
+        CapturePredicate predicate,
+        NoticeTransaction::Mode mode)
         : _predicate(predicate)
     {
         _makeContext = [=]() {
-            return new NoticeTransaction(stage, _predicate);
+            return new NoticeTransaction(stage, _predicate, mode);
         };
     }
 
@@ -65,7 +79,13 @@ struct PythonNoticeTransaction {
     }
 
     // Drop the shared_ptr.
-    void __exit__(object, object, object) { _context.reset(); }
+    void __exit__(object, object, object)
+    {
+        // Release the GIL while notices are merged and sent. It is acquired
+        // again by Python predicates and listeners.
+        TfPyAllowThreadsInScope allowThreads;
+        _context.reset();
+    }
 
     BrokerPtr GetBroker() { return _context->GetBroker(); }
 
@@ -77,32 +97,116 @@ struct PythonNoticeTransaction {
     CapturePredicate _predicate = CapturePredicate::Default();
 };
 
+// Return brokers from list of stages or brokers.
+static std::vector<BrokerPtr> _ExtractBrokers(object targets)
+{
+    std::vector<BrokerPtr> brokers;
+
+    const long size = len(targets);
+    for (long i = 0; i < size; ++i) {
+        object target = targets[i];
+
+        extract<UsdStageWeakPtr> stage(target);
+        if (stage.check()) {
+            brokers.push_back(Broker::Create(stage()));
+            continue;
+        }
+
+        extract<BrokerWeakPtr> broker(target);
+        if (broker.check()) {
+            brokers.push_back(broker());
+            continue;
+        }
+
+        PyErr_SetString(
+            PyExc_TypeError, "Expected a list of Usd Stages or Brokers.");
+        throw_error_already_set();
+    }
+
+    return brokers;
+}
+
+// Expose C++ RAII class as python context manager.
+struct PythonMultiNoticeTransaction {
+    PythonMultiNoticeTransaction(
+        object targets, const _CapturePredicateFunc& func)
+        : _func(func)
+    {
+        const auto brokers = _ExtractBrokers(targets);
+        _makeContext = [=]() {
+            return new MultiNoticeTransaction(brokers, WrapPredicate(_func));
+        };
+    }
+
+    PythonMultiNoticeTransaction(object targets, CapturePredicate predicate)
+        : _predicate(predicate)
+    {
+        const auto brokers = _ExtractBrokers(targets);
+        _makeContext = [=]() {
+            return new MultiNoticeTransaction(brokers, _predicate);
+        };
+    }
+
+    // Instantiate the C++ class object and hold it by shared_ptr.
+    PythonMultiNoticeTransaction const* __enter__()
+    {
+        _context.reset(_makeContext());
+        return this;
+    }
+
+    // Drop the shared_ptr.
+    void __exit__(object, object, object)
+    {
+        // Release the GIL while notices are merged and sent. It is acquired
+        // again by Python predicates and listeners.
+        TfPyAllowThreadsInScope allowThreads;
+        _context.reset();
+    }
+
+    std::vector<BrokerPtr> GetBrokers() { return _context->GetBrokers(); }
+
+  private:
+    std::shared_ptr<MultiNoticeTransaction> _context;
+    std::function<MultiNoticeTransaction*()> _makeContext;
+
+    _CapturePredicateFunc _func = nullptr;
+    CapturePredicate _predicate = CapturePredicate::Default();
+};
+
 void wrapTransaction()
 {
     // Ensure that predicate function can be passed from Python.
     TfPyFunctionFromPython<_CapturePredicateFuncRaw>();
 
-    class_<PythonNoticeTransaction>(
+    scope transaction = class_<PythonNoticeTransaction>(
         "NoticeTransaction",
         "Context manager object which consolidates and filter notices derived "
         "from UnfNotice.StageNotice within a specific scope",
         no_init)
 
-        .def(init<const BrokerWeakPtr&, CapturePredicate>(
-            (arg("broker"), arg("predicate") = CapturePredicate::Default()),
+        .def(init<const BrokerWeakPtr&, CapturePredicate,
+                  NoticeTransaction::Mode>(
+            (arg("broker"), arg("predicate") = CapturePredicate::Default(),
+             arg("mode") = NoticeTransaction::Mode::Default),
             "Create transaction from a Broker."))
 
-        .def(init<const BrokerWeakPtr&, const _CapturePredicateFunc&>(
-            (arg("broker"), arg("predicate")),
+        .def(init<const BrokerWeakPtr&, const _CapturePredicateFunc&,
+                  NoticeTransaction::Mode>(
+            (arg("broker"), arg("predicate"),
+             arg("mode") = NoticeTransaction::Mode::Default),
             "Create transaction from a Broker with a capture predicate "
             "function."))
 
-        .def(init<const UsdStageWeakPtr&, CapturePredicate>(
-            (arg("stage"), arg("predicate") = CapturePredicate::Default()),
+        .def(init<const UsdStageWeakPtr&, CapturePredicate,
+                  NoticeTransaction::Mode>(
+            (arg("stage"), arg("predicate") = CapturePredicate::Default(),
+             arg("mode") = NoticeTransaction::Mode::Default),
             "Create transaction from a UsdStage."))
 
-        .def(init<const UsdStageWeakPtr&, const _CapturePredicateFunc&>(
-            (arg("stage"), arg("predicate")),
+        .def(init<const UsdStageWeakPtr&, const _CapturePredicateFunc&,
+                  NoticeTransaction::Mode>(
+            (arg("stage"), arg("predicate"),
+             arg("mode") = NoticeTransaction::Mode::Default),
             "Create transaction from a UsdStage with a capture predicate "
             "function."))
 
@@ -118,4 +222,40 @@ void wrapTransaction()
             &PythonNoticeTransaction::GetBroker,
             "Return associated Broker instance.",
             return_value_policy<return_by_value>());
+
+    enum_<NoticeTransaction::Mode>("Mode")
+        .value("Default", NoticeTransaction::Mode::Default)
+        .value("ChangeBlock", NoticeTransaction::Mode::ChangeBlock);
+}
+
+void wrapMultiTransaction()
+{
+    class_<PythonMultiNoticeTransaction>(
+        "MultiNoticeTransaction",
+        "Context manager object which consolidates and filter notices derived "
+        "from UnfNotice.StageNotice within a specific scope for several "
+        "stages at once",
+        no_init)
+
+        .def(init<object, CapturePredicate>(
+            (arg("targets"), arg("predicate") = CapturePredicate::Default()),
+            "Create transaction from a list of UsdStages or Brokers."))
+
+        .def(init<object, const _CapturePredicateFunc&>(
+            (arg("targets"), arg("predicate")),
+            "Create transaction from a list of UsdStages or Brokers with a "
+            "capture predicate function."))
+
+        .def(
+            "__enter__",
+            &PythonMultiNoticeTransaction::__enter__,
+            return_internal_reference<>())
+
+        .def("__exit__", &PythonMultiNoticeTransaction::__exit__)
+
+        .def(
+            "GetBrokers",
+            &PythonMultiNoticeTransaction::GetBrokers,
+            "Return associated Broker instances.",
+            return_value_policy<TfPySequenceToList>());
 }
@@ -2,16 +2,127 @@
 #include "unf/capturePredicate.h"
 #include "unf/dispatcher.h"
 #include "unf/notice.h"
-
+#include "unf/recorder.h"
+
+#include <pxr/base/plug/notice.h>
+#include <pxr/base/plug/plugin.h>
+#include <pxr/base/plug/registry.h>
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/mallocTag.h>
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/base/tf/weakBase.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/notice.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace unf {
 
+namespace {
+
+// Process-wide cache of dispatcher types discovered from plugins.
+//
+// Plugins are scanned and loaded once, and scanned again after new plugins
+// are registered, so that creating a broker only instantiates dispatchers.
+class _DispatcherRegistry : public TfWeakBase {
+  public:
+    struct Entry {
+        TfType type;
+        std::string pluginName;
+        DispatcherFactory* factory;
+    };
+
+    static _DispatcherRegistry& GetInstance()
+    {
+        // Leaked on purpose, as brokers can be destroyed during exit.
+        static _DispatcherRegistry* instance = new _DispatcherRegistry();
+        return *instance;
+    }
+
+    std::vector<Entry> GetEntries()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Plugins registered while discovering invalidate the cache again.
+        if (!_valid.exchange(true)) {
+            _Discover();
+        }
+
+        return _entries;
+    }
+
+  private:
+    _DispatcherRegistry()
+    {
+        auto self = TfCreateWeakPtr(this);
+        TfNotice::Register(self, &_DispatcherRegistry::_OnDidRegisterPlugins);
+    }
+
+    void _OnDidRegisterPlugins(const PlugNotice::DidRegisterPlugins&)
+    {
+        _valid = false;
+    }
+
+    void _Discover()
+    {
+        _entries.clear();
+
+        TfType root = TfType::Find<Dispatcher>();
+        std::set<TfType> types;
+        PlugRegistry::GetAllDerivedTypes(root, &types);
+
+        for (const TfType& type : types) {
+            const PlugPluginPtr plugin =
+                PlugRegistry::GetInstance().GetPluginForType(type);
+
+            if (!plugin) {
+                continue;
+            }
+
+            if (!plugin->Load()) {
+                TF_CODING_ERROR(
+                    "Failed to load plugin %s for %s",
+                    plugin->GetName().c_str(),
+                    type.GetTypeName().c_str());
+                continue;
+            }
+
+            auto* factory = type.GetFactory<DispatcherFactory>();
+            if (!factory) {
+                TF_CODING_ERROR(
+                    "Failed to manufacture %s from plugin %s",
+                    type.GetTypeName().c_str(),
+                    plugin->GetName().c_str());
+                continue;
+            }
+
+            _entries.push_back({type, plugin->GetName(), factory});
+        }
+    }
+
+    std::vector<Entry> _entries;
+    std::mutex _mutex;
+    std::atomic<bool> _valid{false};
+};
+
+}  // anonymous namespace
+
 // Initiate static registry.
 std::unordered_map<UsdStageWeakPtr, BrokerPtr, Broker::UsdStageWeakPtrHasher>
     Broker::Registry;
@@ -27,7 +138,7 @@ Broker::Broker(const UsdStageWeakPtr& stage) : _stage(stage)
 
     // Register all dispatchers
     for (auto& element : _dispatcherMap) {
-        element.second->Register();
+        _Register(element.second);
     }
 }
 
@@ -49,12 +160,22 @@ bool Broker::IsInTransaction() { return _mergers.size() > 0; }
 
 void Broker::BeginTransaction(CapturePredicate predicate)
 {
+    if (_recorder) _recorder->_RecordBeginTransaction();
+
     _mergers.push_back(_NoticeMerger(predicate));
+
+    // All notices are requested while a transaction is open.
+    if (_mergers.size() == 1) _UpdateRegistrations();
 }
 
 void Broker::BeginTransaction(const CapturePredicateFunc& function)
 {
+    if (_recorder) _recorder->_RecordBeginTransaction();
+
     _mergers.push_back(_NoticeMerger(CapturePredicate(function)));
+
+    // All notices are requested while a transaction is open.
+    if (_mergers.size() == 1) _UpdateRegistrations();
 }
 
 void Broker::EndTransaction()
@@ -63,13 +184,40 @@ void Broker::EndTransaction()
         return;
     }
 
+    _MergeTransaction();
+    _CloseTransaction();
+}
+
+void Broker::_MergeTransaction()
+{
+    // Notices are only processed by the last merger left.
+    if (_mergers.size() != 1) return;
+
+    _NoticeMerger& merger = _mergers.back();
+    merger.Merge();
+    merger.PostProcess(_coarseningPolicy);
+}
+
+void Broker::_CloseTransaction()
+{
+    if (!IsInTransaction()) {
+        return;
+    }
+
+    if (_recorder) _recorder->_RecordEndTransaction();
+
     _NoticeMerger& merger = _mergers.back();
 
-    // If there are only one merger left, process all notices.
+    // If there are only one merger left, send all notices merged.
     if (_mergers.size() == 1) {
-        merger.Merge();
-        merger.PostProcess();
-        merger.Send(_stage);
+        // Notices may have been captured after the merge when the
+        // transaction spans several brokers.
+        if (merger.IsDirty()) {
+            merger.Merge();
+            merger.PostProcess(_coarseningPolicy);
+        }
+
+        merger.Send(*this);
     }
     // Otherwise, it means that we are in a nested transaction that should
     // not be processed yet. Join data with next merger.
@@ -78,19 +226,245 @@ void Broker::EndTransaction()
     }
 
     _mergers.pop_back();
+
+    if (_mergers.empty()) _UpdateRegistrations();
+}
+
+bool Broker::Accepts(const TfNotice& notice, const TfType& type) const
+{
+    if (_mergers.empty()) return true;
+    return _mergers.back().Accepts(notice, type);
 }
 
 void Broker::Send(const UnfNotice::StageNoticeRefPtr& notice)
 {
     if (_mergers.size() > 0) {
-        _mergers.back().Add(notice);
+        UnfNotice::StageNoticeRefPtr _notice;
+        const bool captured = _mergers.back().Add(
+            notice, _recorder ? std::addressof(_notice) : nullptr);
+
+        // Record notice trimmed by the capture predicate, so that the
+        // recording reproduces the content merged.
+        if (_recorder) {
+            _recorder->_RecordSend(captured ? _notice : notice);
+            _recorder->_RecordCapture(captured);
+        }
     }
     // Otherwise, send the notice.
     else {
-        notice->Send(_stage);
+        if (_recorder) _recorder->_RecordSend(notice);
+
+        _Journal({notice});
+        _Emit({notice});
+    }
+}
+
+void Broker::RemoveConcurrentListener(size_t key) { _RemoveListener(key); }
+
+void Broker::_RemoveListener(size_t key)
+{
+    for (auto it = _listeners.begin(); it != _listeners.end(); ++it) {
+        auto& listeners = it->second;
+        const auto end = std::remove_if(
+            listeners.begin(),
+            listeners.end(),
+            [&](const _Listener& listener) { return listener.key == key; });
+
+        if (end == listeners.end()) continue;
+
+        listeners.erase(end, listeners.end());
+        if (listeners.empty()) _listeners.erase(it);
+        break;
+    }
+
+    _deliveryListeners.clear();
+    _UpdateRegistrations();
+}
+
+Subscription Broker::Subscribe(
+    const TfType& type, const NoticeListenerFunc& callback)
+{
+    if (!type.IsA<UnfNotice::StageNotice>()) {
+        TF_CODING_ERROR(
+            "Type '%s' is not derived from unf::UnfNotice::StageNotice.",
+            type.GetTypeName().c_str());
+        return Subscription();
+    }
+
+    const size_t key = _AddListener(type, callback, false);
+    return Subscription(TfCreateWeakPtr(this), key);
+}
+
+void Broker::SetTfNoticeDelivery(bool enabled)
+{
+    _tfNoticeDelivery = enabled;
+}
+
+bool Broker::IsTfNoticeDeliveryEnabled() const { return _tfNoticeDelivery; }
+
+void Broker::SetConcurrentDelivery(bool enabled)
+{
+    _concurrentDelivery = enabled;
+}
+
+bool Broker::IsConcurrentDeliveryEnabled() const
+{
+    return _concurrentDelivery;
+}
+
+void Broker::SetCoarseningPolicy(const CoarseningPolicy& policy)
+{
+    _coarseningPolicy = policy;
+}
+
+const CoarseningPolicy& Broker::GetCoarseningPolicy() const
+{
+    return _coarseningPolicy;
+}
+
+void Broker::SetCommitDelivery(CommitDelivery delivery)
+{
+    _commitDelivery = delivery;
+}
+
+Broker::CommitDelivery Broker::GetCommitDelivery() const
+{
+    return _commitDelivery;
+}
+
+void Broker::SetJournalCapacity(size_t capacity)
+{
+    size_t previous;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+
+        previous = _journalCapacity.exchange(capacity);
+        while (_journal.size() > capacity) {
+            _journal.pop_front();
+        }
+    }
+
+    // All notices are requested while the journal is enabled.
+    if ((previous == 0) != (capacity == 0)) _UpdateRegistrations();
+}
+
+size_t Broker::GetJournalCapacity() const { return _journalCapacity; }
+
+uint64_t Broker::GetJournalSequence() const { return _journalSequence; }
+
+JournalChanges Broker::GetJournalChanges(uint64_t sequence) const
+{
+    JournalChanges changes;
+
+    std::vector<UnfNotice::StageNoticeRefPtr> notices;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+
+        changes.sequence = _journalSequence;
+        if (sequence >= changes.sequence) return changes;
+
+        // Emissions after the sequence requested must all be recorded.
+        const uint64_t oldest = _journal.empty()
+                                    ? changes.sequence + 1
+                                    : _journal.front().sequence;
+        changes.resyncAll = sequence + 1 < oldest;
+
+        for (const auto& entry : _journal) {
+            if (entry.sequence <= sequence) continue;
+            notices.insert(
+                notices.end(), entry.notices.begin(), entry.notices.end());
+        }
+    }
+
+    if (notices.empty()) return changes;
+
+    TfAutoMallocTag tag("unf", "Broker::GetJournalChanges");
+
+    // Notices recorded are shared with listeners, so they are copied before
+    // being merged.
+    _NoticeMerger merger;
+    for (const auto& notice : notices) {
+        merger.Add(notice->Clone());
+    }
+    merger.Merge();
+    merger.PostProcess(CoarseningPolicy());
+
+    changes.notice = UnfNotice::TransactionCommitted::Create(merger.Collect());
+    return changes;
+}
+
+void Broker::_Journal(const std::vector<UnfNotice::StageNoticeRefPtr>& notices)
+{
+    // Only the sequence is updated when the journal is disabled, so that
+    // emissions do not contend with consumers polling on other threads.
+    if (_journalCapacity == 0) {
+        _journalSequence += 1;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_journalMutex);
+
+    const uint64_t sequence = ++_journalSequence;
+    const size_t capacity = _journalCapacity;
+    if (capacity == 0) return;
+
+    while (_journal.size() >= capacity) _journal.pop_front();
+    _journal.push_back({sequence, notices});
+}
+
+void Broker::SetLazyRegistration(bool enabled)
+{
+    if (_lazyRegistration == enabled) return;
+
+    _lazyRegistration = enabled;
+    _UpdateRegistrations();
+}
+
+bool Broker::IsLazyRegistrationEnabled() const { return _lazyRegistration; }
+
+void Broker::RequestNotices(const TfType& type)
+{
+    if (_requests[type]++ == 0) _UpdateRegistrations();
+}
+
+void Broker::ReleaseNotices(const TfType& type)
+{
+    auto it = _requests.find(type);
+    if (it == _requests.end()) {
+        TF_CODING_ERROR(
+            "Notices of type %s were not requested.",
+            type.GetTypeName().c_str());
+        return;
+    }
+
+    if (--it->second == 0) {
+        _requests.erase(it);
+        _UpdateRegistrations();
     }
 }
 
+bool Broker::IsRequested(const TfType& type) const
+{
+    const bool requested = [&]() {
+        if (!_lazyRegistration || !_mergers.empty()) return true;
+        if (_journalCapacity > 0) return true;
+
+        for (const auto& element : _requests) {
+            if (type.IsA(element.first)) return true;
+        }
+
+        for (const auto& element : _listeners) {
+            if (type.IsA(element.first)) return true;
+        }
+
+        return false;
+    }();
+
+    if (_registering) _registering->push_back({type, requested});
+
+    return requested;
+}
+
 DispatcherPtr& Broker::GetDispatcher(std::string identifier)
 {
     return _dispatcherMap.at(identifier);
@@ -116,15 +490,265 @@ void Broker::_CleanCache()
 
 void Broker::_DiscoverDispatchers()
 {
-    TfType root = TfType::Find<Dispatcher>();
-    std::set<TfType> types;
-    PlugRegistry::GetAllDerivedTypes(root, &types);
+    const auto self = TfCreateWeakPtr(this);
 
-    for (const TfType& type : types) {
-        _LoadFromPlugins<DispatcherPtr, DispatcherFactory>(type);
+    for (const auto& entry : _DispatcherRegistry::GetInstance().GetEntries()) {
+        DispatcherPtr dispatcher = entry.factory->New(self);
+
+        if (!dispatcher) {
+            TF_CODING_ERROR(
+                "Failed to manufacture %s from plugin %s",
+                entry.type.GetTypeName().c_str(),
+                entry.pluginName.c_str());
+            continue;
+        }
+
+        _Add(dispatcher);
+    }
+}
+
+void Broker::_UpdateRegistrations()
+{
+    for (auto& element : _dispatcherMap) {
+        const auto& requests = _dispatcherRequests[element.first];
+
+        const bool changed = std::any_of(
+            requests.begin(), requests.end(), [&](const auto& request) {
+                return IsRequested(request.first) != request.second;
+            });
+
+        if (!changed) continue;
+
+        element.second->Revoke();
+        _Register(element.second);
     }
 }
 
+void Broker::_Register(const DispatcherPtr& dispatcher)
+{
+    _RequestedTypes& requests =
+        _dispatcherRequests[dispatcher->GetIdentifier()];
+    requests.clear();
+
+    _registering = &requests;
+    dispatcher->Register();
+    _registering = nullptr;
+}
+
+size_t Broker::_AddListener(
+    const TfType& type, const NoticeListenerFunc& callback, bool threadSafe)
+{
+    const size_t key = _nextListenerKey++;
+    _listeners[type].push_back({key, type, callback, threadSafe});
+    _deliveryListeners.clear();
+    _UpdateRegistrations();
+    return key;
+}
+
+void Broker::SetChunkedDelivery(size_t size)
+{
+    _chunkSize = size;
+
+    if (_chunkSize == 0) {
+        FlushNotices();
+    }
+}
+
+size_t Broker::GetChunkedDeliverySize() const { return _chunkSize; }
+
+bool Broker::HasPendingNotices() const { return !_pendingNotices.empty(); }
+
+size_t Broker::PumpNotices(size_t count)
+{
+    size_t emitted = 0;
+
+    while (emitted < count && !_pendingNotices.empty()) {
+        auto notice = _pendingNotices.front();
+        _pendingNotices.pop_front();
+
+        _Deliver({notice});
+        emitted++;
+    }
+
+    return emitted;
+}
+
+size_t Broker::PumpNoticesFor(std::chrono::microseconds budget)
+{
+    const auto start = std::chrono::steady_clock::now();
+    size_t emitted = 0;
+
+    while (!_pendingNotices.empty()) {
+        emitted += PumpNotices(1);
+
+        if (std::chrono::steady_clock::now() - start >= budget) break;
+    }
+
+    return emitted;
+}
+
+size_t Broker::GetMemoryUsage() const
+{
+    size_t size = 0;
+
+    for (const auto& merger : _mergers) {
+        size += merger.GetMemoryUsage();
+    }
+
+    for (const auto& notice : _pendingNotices) {
+        size += notice->GetMemoryUsage();
+    }
+
+    return size;
+}
+
+size_t Broker::FlushNotices()
+{
+    return PumpNotices(_pendingNotices.size());
+}
+
+void Broker::_Emit(const std::vector<UnfNotice::StageNoticeRefPtr>& notices)
+{
+    if (_chunkSize == 0) {
+        _Deliver(notices);
+        return;
+    }
+
+    std::vector<UnfNotice::StageNoticeRefPtr> _notices;
+    _notices.reserve(notices.size());
+
+    for (const auto& notice : notices) {
+        auto objectsChanged =
+            TfDynamic_cast<TfRefPtr<UnfNotice::ObjectsChanged> >(notice);
+
+        if (!objectsChanged) {
+            _notices.push_back(notice);
+            continue;
+        }
+
+        const size_t size = objectsChanged->GetResyncedPaths().size()
+                            + objectsChanged->GetChangedInfoOnlyPaths().size();
+
+        // Hold notice if chunks are already pending to preserve the order
+        // of changes.
+        if (size <= _chunkSize && _pendingNotices.empty()) {
+            _notices.push_back(notice);
+            continue;
+        }
+
+        for (auto& chunk : objectsChanged->Split(_chunkSize)) {
+            _pendingNotices.push_back(chunk);
+        }
+    }
+
+    _Deliver(_notices);
+}
+
+void Broker::_Commit(const std::vector<UnfNotice::StageNoticeRefPtr>& notices)
+{
+    if (!notices.empty()) _Journal(notices);
+
+    if (_commitDelivery != CommitDelivery::Composite) {
+        _Emit(notices);
+    }
+
+    if (_commitDelivery != CommitDelivery::Separate && !notices.empty()) {
+        _Deliver({UnfNotice::TransactionCommitted::Create(notices)});
+    }
+}
+
+void Broker::_Deliver(
+    const std::vector<UnfNotice::StageNoticeRefPtr>& notices)
+{
+    if (_listeners.empty()) {
+        if (!_tfNoticeDelivery) return;
+
+        for (const auto& notice : notices) {
+            notice->Send(_stage);
+        }
+        return;
+    }
+
+    // Hold listeners so that they can safely be added or removed by
+    // listeners invoked on the calling thread.
+    std::vector<_ListenerListPtr> listenerLists;
+    listenerLists.reserve(notices.size());
+
+    // Each notice is delivered unchanged to all listeners, so that
+    // thread-safe listeners can receive it in parallel.
+    tbb::task_group group;
+
+    for (const auto& notice : notices) {
+        listenerLists.push_back(_GetListeners(*notice));
+        const auto& listeners = *listenerLists.back();
+
+        if (_concurrentDelivery) {
+            for (const auto& listener : listeners) {
+                if (!listener.threadSafe) continue;
+
+                group.run([&listener, &notice]() {
+                    listener.callback(*notice);
+                });
+            }
+        }
+
+        if (_tfNoticeDelivery) notice->Send(_stage);
+
+        for (const auto& listener : listeners) {
+            if (_concurrentDelivery && listener.threadSafe) continue;
+
+            listener.callback(*notice);
+        }
+    }
+
+    // Wait for all listeners to return before the notices are released.
+    group.wait();
+}
+
+Broker::_ListenerListPtr Broker::_GetListeners(
+    const UnfNotice::StageNotice& notice)
+{
+    const std::type_index index(typeid(notice));
+
+    auto typeIt = _noticeTypes.find(index);
+    if (typeIt == _noticeTypes.end()) {
+        typeIt = _noticeTypes.emplace(index, TfType::Find(typeid(notice)))
+                     .first;
+    }
+    const TfType& type = typeIt->second;
+
+    auto it = _deliveryListeners.find(type);
+    if (it != _deliveryListeners.end()) return it->second;
+
+    auto listeners = std::make_shared<_ListenerList>();
+
+    // Listeners subscribed to the notice type itself do not require any
+    // type check.
+    auto exactIt = _listeners.find(type);
+    if (exactIt != _listeners.end()) {
+        listeners->insert(
+            listeners->end(), exactIt->second.begin(), exactIt->second.end());
+    }
+
+    for (const auto& element : _listeners) {
+        if (element.first == type || !type.IsA(element.first)) continue;
+
+        listeners->insert(
+            listeners->end(), element.second.begin(), element.second.end());
+    }
+
+    // Preserve the registration order across notice types.
+    std::sort(
+        listeners->begin(),
+        listeners->end(),
+        [](const _Listener& lhs, const _Listener& rhs) {
+            return lhs.key < rhs.key;
+        });
+
+    _deliveryListeners.emplace(type, listeners);
+    return listeners;
+}
+
 void Broker::_Add(const DispatcherPtr& dispatcher)
 {
     _dispatcherMap[dispatcher->GetIdentifier()] = dispatcher;
@@ -135,42 +759,120 @@ Broker::_NoticeMerger::_NoticeMerger(CapturePredicate predicate)
 {
 }
 
-void Broker::_NoticeMerger::Add(const UnfNotice::StageNoticeRefPtr& notice)
+bool Broker::_NoticeMerger::Add(
+    const UnfNotice::StageNoticeRefPtr& notice,
+    UnfNotice::StageNoticeRefPtr* captured)
 {
     // Indicate whether the notice needs to be captured.
-    if (!_predicate(*notice)) return;
+    if (!_predicate(*notice)) return false;
+
+    TfAutoMallocTag tag("unf", "Broker::_NoticeMerger::Add");
+
+    // Copy notice before trimming if it is referenced elsewhere.
+    const bool trim = _predicate.HasTrimFunction();
+    UnfNotice::StageNoticeRefPtr _notice =
+        (trim && !notice->IsUnique()) ? notice->Clone() : notice;
+
+    if (trim && !_predicate.Trim(*_notice)) return false;
+
+    if (captured) *captured = _notice;
 
     // Store notices per type name, so that each type can be merged if
     // required.
-    std::string name = notice->GetTypeId();
-    _noticeMap[name].push_back(notice);
+    std::string name = _notice->GetTypeId();
+    _Insert(_GetList(name), std::move(_notice));
+
+    // Notices added by listeners of another broker when a multi-broker
+    // transaction ends must be merged again.
+    if (_merged) _dirty = true;
+
+    return true;
+}
+
+Broker::_NoticeMerger::_NoticePtrList& Broker::_NoticeMerger::_GetList(
+    const std::string& name)
+{
+    auto result = _noticeMap.emplace(name, _NoticePtrList());
+
+    // Record order in which types are captured to emit notices in a
+    // deterministic order.
+    if (result.second) _order.push_back(name);
+
+    return result.first->second;
+}
+
+void Broker::_NoticeMerger::_Insert(
+    _NoticePtrList& notices, UnfNotice::StageNoticeRefPtr notice)
+{
+    // Enforce merge policy while capturing, so that the number of notices
+    // kept does not grow with the number of edits.
+    const MergePolicy policy = notice->GetMergePolicy();
+
+    switch (policy.GetMode()) {
+        case MergePolicy::Mode::KeepLatest:
+            notices.clear();
+            break;
+        case MergePolicy::Mode::KeepFirstAndLast:
+            if (notices.size() >= 2) notices.pop_back();
+            break;
+        case MergePolicy::Mode::BoundedRing:
+            if (notices.size() >= policy.GetCapacity()) {
+                notices.erase(
+                    notices.begin(),
+                    std::next(
+                        notices.begin(),
+                        notices.size() - policy.GetCapacity() + 1));
+            }
+            break;
+        default:
+            break;
+    }
+
+    notices.push_back(std::move(notice));
+}
+
+bool Broker::_NoticeMerger::Accepts(
+    const TfNotice& notice, const TfType& type) const
+{
+    return _predicate.Accepts(notice, type);
 }
 
 void Broker::_NoticeMerger::Join(_NoticeMerger& merger)
 {
-    for (auto& element : merger._noticeMap) {
-        auto& source = element.second;
-        auto& target = _noticeMap[element.first];
+    TfAutoMallocTag tag("unf", "Broker::_NoticeMerger::Join");
 
-        target.reserve(target.size() + source.size());
-        std::move(
-            std::begin(source), std::end(source), std::back_inserter(target));
+    for (const auto& name : merger._order) {
+        auto& source = merger._noticeMap[name];
+        auto& target = _GetList(name);
+
+        for (auto& notice : source) {
+            _Insert(target, std::move(notice));
+        }
 
         source.clear();
     }
 
     merger._noticeMap.clear();
+    merger._order.clear();
 }
 
 void Broker::_NoticeMerger::Merge()
 {
+    TfAutoMallocTag tag("unf", "Broker::_NoticeMerger::Merge");
+
+    _merged = true;
+    _dirty = false;
+
     for (auto& element : _noticeMap) {
         auto& notices = element.second;
 
         // If there are more than one notice for this type and
         // if the notices are mergeable, we only need to keep the
-        // first notice, and all other can be pruned.
-        if (notices.size() > 1 && notices[0]->IsMergeable()) {
+        // first notice, and all other can be pruned. Other policies
+        // are already enforced during capture.
+        if (notices.size() > 1
+            && notices[0]->GetMergePolicy().GetMode()
+                   == MergePolicy::Mode::Merge) {
             auto& notice = notices.at(0);
 
             auto it = std::next(notices.begin());
@@ -184,24 +886,112 @@ void Broker::_NoticeMerger::Merge()
     }
 }
 
-void Broker::_NoticeMerger::PostProcess()
+size_t Broker::_NoticeMerger::GetMemoryUsage() const
+{
+    size_t size = 0;
+
+    for (const auto& element : _noticeMap) {
+        for (const auto& notice : element.second) {
+            size += notice->GetMemoryUsage();
+        }
+    }
+
+    return size;
+}
+
+void Broker::_NoticeMerger::PostProcess(const CoarseningPolicy& policy)
 {
     for (auto& element : _noticeMap) {
         auto& notice = element.second[0];
         notice->PostProcess();
+
+        if (!policy.IsEnabled()) continue;
+
+        auto _notice =
+            TfDynamic_cast<TfRefPtr<UnfNotice::ObjectsChanged> >(notice);
+        if (_notice) _notice->Coarsen(policy);
     }
 }
 
-void Broker::_NoticeMerger::Send(const UsdStageWeakPtr& stage)
+Broker::_NoticeMerger::_NoticePtrList Broker::_NoticeMerger::Collect() const
 {
-    for (auto& element : _noticeMap) {
-        auto& notices = element.second;
+    _NoticePtrList notices;
 
-        // Send all remaining notices.
-        for (const auto& notice : element.second) {
-            notice->Send(stage);
-        }
+    for (const auto& name : _order) {
+        const auto& list = _noticeMap.at(name);
+        notices.insert(notices.end(), list.begin(), list.end());
     }
+
+    return notices;
+}
+
+void Broker::_NoticeMerger::Send(Broker& broker)
+{
+    // Send all remaining notices.
+    broker._Commit(Collect());
+}
+
+JournalCursor::JournalCursor(const BrokerWeakPtr& broker)
+    : _broker(broker), _sequence(broker ? broker->GetJournalSequence() : 0)
+{
+}
+
+JournalCursor::JournalCursor(const BrokerWeakPtr& broker, uint64_t sequence)
+    : _broker(broker), _sequence(sequence)
+{
+}
+
+bool JournalCursor::HasChanges() const
+{
+    return _broker && _broker->GetJournalSequence() > _sequence;
+}
+
+JournalChanges JournalCursor::Fetch()
+{
+    if (!_broker) {
+        TF_CODING_ERROR("Broker has expired.");
+        return JournalChanges();
+    }
+
+    JournalChanges changes = _broker->GetJournalChanges(_sequence);
+    _sequence = changes.sequence;
+    return changes;
+}
+
+Subscription::Subscription(const BrokerWeakPtr& broker, size_t key)
+    : _broker(broker), _key(key)
+{
+}
+
+Subscription::~Subscription() { Reset(); }
+
+Subscription::Subscription(Subscription&& other) noexcept
+    : _broker(std::move(other._broker)), _key(other._key)
+{
+    other._broker = BrokerWeakPtr();
+    other._key = 0;
+}
+
+Subscription& Subscription::operator=(Subscription&& other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        _broker = std::move(other._broker);
+        _key = other._key;
+        other._broker = BrokerWeakPtr();
+        other._key = 0;
+    }
+    return *this;
+}
+
+bool Subscription::IsActive() const { return _broker && _key != 0; }
+
+void Subscription::Reset()
+{
+    if (_broker && _key != 0) _broker->_RemoveListener(_key);
+
+    _broker = BrokerWeakPtr();
+    _key = 0;
 }
 
 }  // namespace unf
@@ -7,27 +7,35 @@
 #include "unf/capturePredicate.h"
 #include "unf/notice.h"
 
-#include <pxr/base/plug/plugin.h>
-#include <pxr/base/plug/registry.h>
 #include <pxr/base/tf/refBase.h>
 #include <pxr/base/tf/refPtr.h>
+#include <pxr/base/tf/type.h>
 #include <pxr/base/tf/weakBase.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace unf {
 
 class Broker;
 class Dispatcher;
+class NoticeRecorder;
 
 /// Convenient alias for Broker reference pointer.
 using BrokerPtr = PXR_NS::TfRefPtr<Broker>;
@@ -38,6 +46,125 @@ using BrokerWeakPtr = PXR_NS::TfWeakPtr<Broker>;
 /// Convenient alias for Dispatcher reference pointer.
 using DispatcherPtr = PXR_NS::TfRefPtr<Dispatcher>;
 
+/// Convenient alias for function invoked with notices emitted by a broker.
+using NoticeListenerFunc = std::function<void(const UnfNotice::StageNotice&)>;
+
+/// \class Subscription
+///
+/// \brief
+/// Handle to a callback registered with Broker::Subscribe.
+///
+/// The callback is unregistered when the handle is destroyed or reset.
+class Subscription {
+  public:
+    /// Create inactive subscription.
+    Subscription() = default;
+
+    /// Unregister callback.
+    UNF_API ~Subscription();
+
+    /// Move constructor.
+    UNF_API Subscription(Subscription&&) noexcept;
+
+    /// Move assignment operator.
+    UNF_API Subscription& operator=(Subscription&&) noexcept;
+
+    /// Remove default copy constructor.
+    Subscription(const Subscription&) = delete;
+
+    /// Remove default assignment operator.
+    Subscription& operator=(const Subscription&) = delete;
+
+    /// Indicate whether the callback is still registered.
+    UNF_API bool IsActive() const;
+
+    /// Unregister callback.
+    UNF_API void Reset();
+
+  private:
+    Subscription(const BrokerWeakPtr& broker, size_t key);
+
+    BrokerWeakPtr _broker;
+    size_t _key = 0;
+
+    friend class Broker;
+};
+
+/// \brief
+/// Changes recorded by the journal of a Broker since a sequence number.
+///
+/// \sa Broker::GetJournalChanges
+struct JournalChanges {
+    /// Sequence number of the latest emission included.
+    uint64_t sequence = 0;
+
+    /// \brief
+    /// Indicate whether emissions requested were dropped from the journal.
+    ///
+    /// The consumer must then rebuild its whole state, as the notice only
+    /// holds the changes which are still recorded.
+    bool resyncAll = false;
+
+    /// \brief
+    /// Notice holding all notices recorded since the sequence number
+    /// requested, consolidated per type.
+    ///
+    /// Null if no emissions were recorded since the sequence number.
+    PXR_NS::TfRefPtr<UnfNotice::TransactionCommitted> notice;
+};
+
+/// \class JournalCursor
+///
+/// \brief
+/// Position of a consumer polling the journal of a Broker.
+///
+/// \code{.cpp}
+/// broker->SetJournalCapacity(100);
+///
+/// unf::JournalCursor cursor(broker);
+///
+/// // Later, e.g. at each frame...
+/// unf::JournalChanges changes = cursor.Fetch();
+/// if (changes.resyncAll) {
+///     // Rebuild whole state...
+/// }
+/// else if (changes.notice) {
+///     for (const auto& notice : changes.notice->GetNotices()) {
+///         // ...
+///     }
+/// }
+/// \endcode
+class JournalCursor {
+  public:
+    /// \brief
+    /// Create cursor positioned at the latest emission recorded by
+    /// \p broker.
+    ///
+    /// Only changes emitted after the creation of the cursor are fetched.
+    UNF_API explicit JournalCursor(const BrokerWeakPtr& broker);
+
+    /// \brief
+    /// Create cursor positioned at \p sequence.
+    ///
+    /// Use zero to fetch all changes recorded by the journal.
+    UNF_API JournalCursor(const BrokerWeakPtr& broker, uint64_t sequence);
+
+    /// Return sequence number of the latest emission fetched.
+    uint64_t GetSequence() const { return _sequence; }
+
+    /// Indicate whether emissions were recorded since the latest fetch.
+    UNF_API bool HasChanges() const;
+
+    /// \brief
+    /// Return changes recorded since the latest fetch, and move the cursor
+    /// to the latest emission recorded.
+    UNF_API JournalChanges Fetch();
+
+  private:
+    BrokerWeakPtr _broker;
+    uint64_t _sequence = 0;
+};
+
 /// \class Broker
 ///
 /// \brief
@@ -140,6 +267,335 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// The associated stage will be used as sender.
     UNF_API void Send(const UnfNotice::StageNoticeRefPtr&);
 
+    /// \brief
+    /// Indicate whether a notice of \p type created from the incoming
+    /// \p notice would be captured by the current transaction.
+    ///
+    /// Dispatchers call this method before creating a standalone notice, so
+    /// that notices dropped by the capture predicate of the innermost
+    /// transaction are never created. Return true if no transaction is open.
+    ///
+    /// \sa CapturePredicate::Accepts
+    UNF_API bool Accepts(
+        const PXR_NS::TfNotice& notice, const PXR_NS::TfType& type) const;
+
+    /// \brief
+    /// Register thread-safe \p callback invoked with each notice of type
+    /// \p T emitted by the broker.
+    ///
+    /// Return a key which can be used to remove the listener.
+    ///
+    /// \code{.cpp}
+    /// broker->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+    ///     [&](const unf::UnfNotice::ObjectsChanged& notice) {
+    ///         // ...
+    ///     });
+    /// \endcode
+    ///
+    /// The listener is invoked after the notice has been sent to listeners
+    /// registered via PXR_NS::TfNotice::Register. If concurrent delivery is
+    /// enabled, all thread-safe listeners receive notices in parallel.
+    ///
+    /// \warning
+    /// The listener must not modify the stage or the broker.
+    ///
+    /// \sa SetConcurrentDelivery
+    template <class T>
+    size_t AddConcurrentListener(
+        const std::function<void(const T&)>& callback);
+
+    /// Remove listener registered with AddConcurrentListener.
+    UNF_API void RemoveConcurrentListener(size_t key);
+
+    /// \brief
+    /// Register \p callback invoked with each notice of type \p T emitted
+    /// by the broker.
+    ///
+    /// Return a handle which unregisters the callback when destroyed.
+    ///
+    /// \code{.cpp}
+    /// unf::Subscription subscription =
+    ///     broker->Subscribe<unf::UnfNotice::ObjectsChanged>(
+    ///         [&](const unf::UnfNotice::ObjectsChanged& notice) {
+    ///             // ...
+    ///         });
+    /// \endcode
+    ///
+    /// The callback is invoked directly on the calling thread, after the
+    /// notice has been sent to listeners registered via
+    /// PXR_NS::TfNotice::Register. This avoids the cost of the
+    /// PXR_NS::TfNotice registry, which can be skipped entirely with
+    /// SetTfNoticeDelivery.
+    ///
+    /// \note
+    /// A callback unregistered while notices are being delivered can still
+    /// be invoked with the remaining notices of the current delivery.
+    template <class T>
+    Subscription Subscribe(const std::function<void(const T&)>& callback);
+
+    /// \brief
+    /// Register \p callback invoked with each notice of \p type emitted by
+    /// the broker.
+    ///
+    /// A coding error is raised and an inactive handle is returned if
+    /// \p type is not derived from UnfNotice::StageNotice.
+    UNF_API Subscription Subscribe(
+        const PXR_NS::TfType& type, const NoticeListenerFunc& callback);
+
+    /// \brief
+    /// Indicate whether notices emitted should be sent via
+    /// PXR_NS::TfNotice::Send.
+    ///
+    /// Disabling it removes the cost of the PXR_NS::TfNotice registry when
+    /// all listeners are registered via Subscribe or AddConcurrentListener.
+    /// Listeners registered via PXR_NS::TfNotice::Register will not receive
+    /// notices emitted by the broker anymore.
+    ///
+    /// TfNotice delivery is enabled by default.
+    UNF_API void SetTfNoticeDelivery(bool enabled);
+
+    /// Indicate whether TfNotice delivery is enabled.
+    UNF_API bool IsTfNoticeDeliveryEnabled() const;
+
+    /// \brief
+    /// Indicate whether thread-safe listeners should be invoked in parallel.
+    ///
+    /// When enabled, each notice emitted is delivered to thread-safe
+    /// listeners on a TBB task group while it is sent to other listeners on
+    /// the calling thread. All listeners have returned when the notice
+    /// emission (e.g. EndTransaction) returns.
+    ///
+    /// Concurrent delivery is disabled by default.
+    ///
+    /// \sa AddConcurrentListener
+    UNF_API void SetConcurrentDelivery(bool enabled);
+
+    /// Indicate whether concurrent delivery is enabled.
+    UNF_API bool IsConcurrentDeliveryEnabled() const;
+
+    /// \brief
+    /// Split large UnfNotice::ObjectsChanged notices into chunks of at most
+    /// \p size paths which are delivered with PumpNotices.
+    ///
+    /// When enabled, emitted UnfNotice::ObjectsChanged notices holding more
+    /// than \p size paths are split with UnfNotice::ObjectsChanged::Split,
+    /// and the chunks are held until pumped. This allows an event loop to
+    /// deliver a large notice across several ticks:
+    ///
+    /// \code{.cpp}
+    /// broker->SetChunkedDelivery(1000);
+    ///
+    /// // On each tick.
+    /// broker->PumpNoticesFor(std::chrono::milliseconds(10));
+    /// \endcode
+    ///
+    /// UnfNotice::ObjectsChanged notices emitted while chunks are pending are
+    /// also held to preserve the order of changes. Other notices are emitted
+    /// immediately.
+    ///
+    /// Setting \p size to zero disables chunked delivery and emits all
+    /// pending chunks.
+    UNF_API void SetChunkedDelivery(size_t size);
+
+    /// \brief
+    /// Return maximum number of paths per chunk, or zero if chunked delivery
+    /// is disabled.
+    UNF_API size_t GetChunkedDeliverySize() const;
+
+    /// Indicate whether chunks are waiting to be delivered.
+    UNF_API bool HasPendingNotices() const;
+
+    /// \brief
+    /// Emit up to \p count pending chunks.
+    ///
+    /// Return the number of chunks emitted.
+    UNF_API size_t PumpNotices(size_t count = 1);
+
+    /// \brief
+    /// Emit pending chunks until \p budget is exceeded.
+    ///
+    /// At least one chunk is emitted if any is pending. Return the number of
+    /// chunks emitted.
+    UNF_API size_t PumpNoticesFor(std::chrono::microseconds budget);
+
+    /// \brief
+    /// Emit all pending chunks.
+    ///
+    /// Return the number of chunks emitted.
+    UNF_API size_t FlushNotices();
+
+    /// \brief
+    /// Return an estimate of the memory held by the broker in bytes.
+    ///
+    /// This includes notices captured by pending transactions and chunks
+    /// waiting to be delivered. Sampling this value before the outermost
+    /// transaction ends gives the peak memory used by the transaction, as
+    /// notices are only merged when it ends.
+    ///
+    /// \sa UnfNotice::StageNotice::GetMemoryUsage
+    UNF_API size_t GetMemoryUsage() const;
+
+    /// \brief
+    /// Set \p policy used to coarsen UnfNotice::ObjectsChanged notices
+    /// when a transaction ends.
+    ///
+    /// Coarsening is applied after notices are merged, so that listeners
+    /// receive a bounded number of paths even for massive edits. Notices
+    /// sent outside of a transaction are not coarsened.
+    ///
+    /// By default, notices are not coarsened.
+    ///
+    /// \sa UnfNotice::ObjectsChanged::Coarsen
+    UNF_API void SetCoarseningPolicy(const CoarseningPolicy& policy);
+
+    /// Return policy used to coarsen notices.
+    UNF_API const CoarseningPolicy& GetCoarseningPolicy() const;
+
+    /// Notices emitted when the outermost transaction ends.
+    enum class CommitDelivery {
+        /// Emit each consolidated notice separately.
+        Separate,
+        /// Emit a single UnfNotice::TransactionCommitted notice.
+        Composite,
+        /// \brief
+        /// Emit each consolidated notice separately, followed by a
+        /// UnfNotice::TransactionCommitted notice.
+        Both,
+    };
+
+    /// \brief
+    /// Set how consolidated notices are emitted when the outermost
+    /// transaction ends.
+    ///
+    /// Notices are always emitted in the order in which their type was
+    /// first captured during the transaction. With
+    /// CommitDelivery::Composite, listeners receive a single
+    /// UnfNotice::TransactionCommitted notice holding all consolidated
+    /// notices instead of one notice per type:
+    ///
+    /// \code{.cpp}
+    /// broker->SetCommitDelivery(unf::Broker::CommitDelivery::Composite);
+    ///
+    /// broker->AddConcurrentListener<unf::UnfNotice::TransactionCommitted>(
+    ///     [&](const unf::UnfNotice::TransactionCommitted& notice) {
+    ///         for (const auto& _notice : notice.GetNotices()) {
+    ///             // ...
+    ///         }
+    ///     });
+    /// \endcode
+    ///
+    /// No UnfNotice::TransactionCommitted notice is emitted if no notices
+    /// were captured. This notice is never split into chunks.
+    ///
+    /// By default, CommitDelivery::Separate is used.
+    ///
+    /// \sa SetChunkedDelivery
+    UNF_API void SetCommitDelivery(CommitDelivery delivery);
+
+    /// Return how consolidated notices are emitted.
+    UNF_API CommitDelivery GetCommitDelivery() const;
+
+    /// \brief
+    /// Set maximum number of emissions recorded by the journal.
+    ///
+    /// Each emission, i.e. each notice sent outside of a transaction and
+    /// all notices consolidated by an outermost transaction, is recorded
+    /// with a monotonically increasing sequence number. Consumers which
+    /// cannot use listeners, or which start listening late, can then poll
+    /// all changes emitted since a sequence number with GetJournalChanges
+    /// or a JournalCursor.
+    ///
+    /// Oldest emissions are dropped when the journal is full. Zero disables
+    /// the journal and drops all emissions recorded, which is the default.
+    ///
+    /// All notices are requested while the journal is enabled, so that
+    /// changes are recorded even if lazy registration is enabled.
+    ///
+    /// \note
+    /// Notices recorded are kept alive by the journal.
+    ///
+    /// \sa SetLazyRegistration
+    UNF_API void SetJournalCapacity(size_t capacity);
+
+    /// Return maximum number of emissions recorded by the journal.
+    UNF_API size_t GetJournalCapacity() const;
+
+    /// \brief
+    /// Return sequence number of the latest emission.
+    ///
+    /// Emissions are numbered from one, even when the journal is disabled.
+    /// Zero is returned if no notices were emitted.
+    UNF_API uint64_t GetJournalSequence() const;
+
+    /// \brief
+    /// Return changes emitted after \p sequence.
+    ///
+    /// Notices recorded are copied and consolidated per type, following
+    /// their MergePolicy, into a single UnfNotice::TransactionCommitted
+    /// notice. JournalChanges::resyncAll is set if some of these emissions
+    /// were dropped from the journal.
+    ///
+    /// This method can be called from any thread.
+    UNF_API JournalChanges GetJournalChanges(uint64_t sequence) const;
+
+    /// \brief
+    /// Indicate whether dispatchers should only listen to incoming notices
+    /// when the notices they emit are requested.
+    ///
+    /// When enabled, listeners registered via Dispatcher::_Register are only
+    /// registered if the output notice type is requested, which is the case
+    /// when:
+    ///
+    /// - The type or one of its bases is requested via RequestNotices.
+    /// - A listener is registered for the type or one of its bases via
+    ///   AddConcurrentListener or Subscribe.
+    /// - A transaction is open.
+    /// - The journal is enabled via SetJournalCapacity.
+    ///
+    /// Lazy registration is disabled by default.
+    ///
+    /// \warning
+    /// Listeners registered via PXR_NS::TfNotice::Register cannot be
+    /// detected, so the notice types they expect must be requested.
+    ///
+    /// \sa IsRequested
+    UNF_API void SetLazyRegistration(bool enabled);
+
+    /// Indicate whether lazy registration is enabled.
+    UNF_API bool IsLazyRegistrationEnabled() const;
+
+    /// \brief
+    /// Request notices of \p type and derived types.
+    ///
+    /// Requests are counted, so each call must be balanced with
+    /// ReleaseNotices.
+    ///
+    /// \sa SetLazyRegistration
+    UNF_API void RequestNotices(const PXR_NS::TfType& type);
+
+    /// Request notices of type \p T and derived types.
+    template <class T>
+    void RequestNotices()
+    {
+        RequestNotices(PXR_NS::TfType::Find<T>());
+    }
+
+    /// Release notices of \p type requested with RequestNotices.
+    UNF_API void ReleaseNotices(const PXR_NS::TfType& type);
+
+    /// Release notices of type \p T requested with RequestNotices.
+    template <class T>
+    void ReleaseNotices()
+    {
+        ReleaseNotices(PXR_NS::TfType::Find<T>());
+    }
+
+    /// \brief
+    /// Indicate whether notices of \p type should be emitted.
+    ///
+    /// Always return true if lazy registration is disabled.
+    UNF_API bool IsRequested(const PXR_NS::TfType& type) const;
+
     /// Return dispatcher reference associated with \p identifier.
     UNF_API DispatcherPtr& GetDispatcher(std::string identifier);
 
@@ -163,12 +619,89 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
   private:
     Broker(const PXR_NS::UsdStageWeakPtr&);
 
+    struct _Listener {
+        size_t key;
+        PXR_NS::TfType type;
+        NoticeListenerFunc callback;
+        bool threadSafe;
+    };
+
+    using _ListenerList = std::vector<_Listener>;
+    using _ListenerListPtr = std::shared_ptr<const _ListenerList>;
+
     /// Un-register brokers targeting expired stages.
     static void _CleanCache();
 
-    /// Discover all dispatchers registered as plugins.
+    /// \brief
+    /// Create all dispatchers registered as plugins.
+    ///
+    /// Plugins are discovered and loaded once per process, and discovered
+    /// again when new plugins are registered.
     void _DiscoverDispatchers();
 
+    /// \brief
+    /// Register dispatchers again when the notice types they queried via
+    /// IsRequested are no longer requested in the same way.
+    ///
+    /// Dispatchers whose requested output types are unchanged are left
+    /// registered.
+    void _UpdateRegistrations();
+
+    /// \brief
+    /// Register \p dispatcher and record the notice types queried via
+    /// IsRequested during the registration.
+    UNF_API void _Register(const DispatcherPtr& dispatcher);
+
+    /// Register listener invoked with notices of \p type.
+    UNF_API size_t _AddListener(
+        const PXR_NS::TfType& type,
+        const NoticeListenerFunc& callback,
+        bool threadSafe);
+
+    /// \brief
+    /// Remove listener identified by \p key, registered via
+    /// AddConcurrentListener or Subscribe.
+    void _RemoveListener(size_t key);
+
+    /// \brief
+    /// Emit \p notices, or hold them as pending chunks if chunked delivery
+    /// is enabled.
+    void _Emit(const std::vector<UnfNotice::StageNoticeRefPtr>& notices);
+
+    /// Send \p notices and invoke registered listeners.
+    void _Deliver(const std::vector<UnfNotice::StageNoticeRefPtr>& notices);
+
+    /// \brief
+    /// Return listeners to invoke with \p notice.
+    ///
+    /// Listeners subscribed to base types of the notice type are only
+    /// looked up on the first delivery of this type.
+    _ListenerListPtr _GetListeners(const UnfNotice::StageNotice& notice);
+
+    /// \brief
+    /// Emit \p notices consolidated by the outermost transaction according
+    /// to the commit delivery.
+    void _Commit(const std::vector<UnfNotice::StageNoticeRefPtr>& notices);
+
+    /// \brief
+    /// Merge notices captured if the current transaction is the outermost
+    /// one.
+    ///
+    /// No notices are emitted, so that brokers associated with different
+    /// stages can be merged in parallel.
+    void _MergeTransaction();
+
+    /// \brief
+    /// Close the current transaction.
+    ///
+    /// Notices merged by _MergeTransaction are emitted if the transaction is
+    /// the outermost one. Otherwise, they are joined with the enclosing
+    /// transaction.
+    void _CloseTransaction();
+
+    /// Record \p notices emitted into the journal.
+    void _Journal(const std::vector<UnfNotice::StageNoticeRefPtr>& notices);
+
     /// Register dispacther within broker by its identifier.
     UNF_API void _Add(const DispatcherPtr&);
 
@@ -177,10 +710,6 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     template <class T>
     DispatcherPtr _AddDispatcher();
 
-    /// Load all dispatchers from discovered factory types.
-    template <class OutputPtr, class OutputFactory>
-    void _LoadFromPlugins(const PXR_NS::TfType& type);
-
     struct UsdStageWeakPtrHasher {
         std::size_t operator()(const PXR_NS::UsdStageWeakPtr& ptr) const
         {
@@ -197,18 +726,45 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
       public:
         _NoticeMerger(CapturePredicate predicate = CapturePredicate::Default());
 
-        void Add(const UnfNotice::StageNoticeRefPtr&);
+        /// \brief
+        /// Capture notice if accepted by the predicate.
+        ///
+        /// The notice captured, which might be a trimmed copy, is returned
+        /// via \p captured if specified.
+        bool Add(
+            const UnfNotice::StageNoticeRefPtr&,
+            UnfNotice::StageNoticeRefPtr* captured = nullptr);
+        bool Accepts(const PXR_NS::TfNotice&, const PXR_NS::TfType&) const;
         void Join(_NoticeMerger&);
         void Merge();
-        void PostProcess();
-        void Send(const PXR_NS::UsdStageWeakPtr&);
+        void PostProcess(const CoarseningPolicy&);
+
+        /// Indicate whether notices were added since the last merge.
+        bool IsDirty() const { return _dirty; }
+
+        size_t GetMemoryUsage() const;
+        std::vector<UnfNotice::StageNoticeRefPtr> Collect() const;
+        void Send(Broker&);
 
       private:
         using _NoticePtrList = std::vector<UnfNotice::StageNoticeRefPtr>;
         using _NoticePtrMap = std::unordered_map<std::string, _NoticePtrList>;
 
+        static void _Insert(_NoticePtrList&, UnfNotice::StageNoticeRefPtr);
+
+        _NoticePtrList& _GetList(const std::string& name);
+
         _NoticePtrMap _noticeMap;
+
+        /// Type names in the order in which they were first captured.
+        std::vector<std::string> _order;
         CapturePredicate _predicate;
+
+        /// Indicate whether notices were merged.
+        bool _merged = false;
+
+        /// Indicate whether notices were added after being merged.
+        bool _dirty = false;
     };
 
     /// Usd Stage associated with broker.
@@ -219,6 +775,84 @@ class Broker : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
 
     /// List of registered Dispatchers.
     std::unordered_map<std::string, DispatcherPtr> _dispatcherMap;
+
+    /// Notice types queried and whether they were requested.
+    using _RequestedTypes = std::vector<std::pair<PXR_NS::TfType, bool>>;
+
+    /// Notice types queried by each dispatcher when registered.
+    std::unordered_map<std::string, _RequestedTypes> _dispatcherRequests;
+
+    /// Notice types queried by the dispatcher being registered if any.
+    _RequestedTypes* _registering = nullptr;
+
+    /// Listeners registered via the broker per notice type subscribed.
+    std::map<PXR_NS::TfType, _ListenerList> _listeners;
+
+    /// \brief
+    /// Listeners invoked for each notice type delivered, in registration
+    /// order.
+    ///
+    /// Cleared when listeners are added or removed.
+    std::map<PXR_NS::TfType, _ListenerListPtr> _deliveryListeners;
+
+    /// Notice types delivered per type id.
+    std::unordered_map<std::type_index, PXR_NS::TfType> _noticeTypes;
+
+    /// Next key used to identify a listener.
+    size_t _nextListenerKey = 1;
+
+    /// Indicate whether thread-safe listeners are invoked in parallel.
+    bool _concurrentDelivery = false;
+
+    /// Indicate whether notices are sent via PXR_NS::TfNotice::Send.
+    bool _tfNoticeDelivery = true;
+
+    /// Maximum number of paths per chunk, or zero if chunked delivery is
+    /// disabled.
+    size_t _chunkSize = 0;
+
+    /// Chunks waiting to be delivered.
+    std::deque<UnfNotice::StageNoticeRefPtr> _pendingNotices;
+
+    /// Policy used to coarsen notices when a transaction ends.
+    CoarseningPolicy _coarseningPolicy;
+
+    /// Indicate how notices are emitted when a transaction ends.
+    CommitDelivery _commitDelivery = CommitDelivery::Separate;
+
+    /// Indicate whether dispatchers only listen to requested notices.
+    bool _lazyRegistration = false;
+
+    /// Number of requests per notice type.
+    std::map<PXR_NS::TfType, size_t> _requests;
+
+    /// Recorder attached to the broker if any.
+    NoticeRecorder* _recorder = nullptr;
+
+    struct _JournalEntry {
+        uint64_t sequence;
+        std::vector<UnfNotice::StageNoticeRefPtr> notices;
+    };
+
+    /// Emissions recorded by the journal, from oldest to latest.
+    std::deque<_JournalEntry> _journal;
+
+    /// Maximum number of emissions recorded by the journal.
+    std::atomic<size_t> _journalCapacity{0};
+
+    /// \brief
+    /// Sequence number of the latest emission.
+    ///
+    /// Only updated while holding the journal mutex if the journal is
+    /// enabled, so that it stays consistent with the entries recorded.
+    std::atomic<uint64_t> _journalSequence{0};
+
+    /// Protect journal from consumers polling on other threads.
+    mutable std::mutex _journalMutex;
+
+    friend class NoticeRecorder;
+    friend class MultiNoticeTransaction;
+    friend class Subscription;
 };
 
 template <class UnfNotice, class... Args>
@@ -227,7 +861,37 @@ void Broker::Send(Args&&... args)
     PXR_NS::TfRefPtr<UnfNotice> _notice =
         UnfNotice::Create(std::forward<Args>(args)...);
 
-    Send(_notice);
+    Send(std::move(_notice));
+}
+
+template <class T>
+size_t Broker::AddConcurrentListener(
+    const std::function<void(const T&)>& callback)
+{
+    static_assert(
+        std::is_base_of<UnfNotice::StageNotice, T>::value,
+        "Expecting a type derived from unf::UnfNotice::StageNotice.");
+
+    return _AddListener(
+        PXR_NS::TfType::Find<T>(),
+        [callback](const UnfNotice::StageNotice& notice) {
+            callback(static_cast<const T&>(notice));
+        },
+        true);
+}
+
+template <class T>
+Subscription Broker::Subscribe(const std::function<void(const T&)>& callback)
+{
+    static_assert(
+        std::is_base_of<UnfNotice::StageNotice, T>::value,
+        "Expecting a type derived from unf::UnfNotice::StageNotice.");
+
+    return Subscribe(
+        PXR_NS::TfType::Find<T>(),
+        [callback](const UnfNotice::StageNotice& notice) {
+            callback(static_cast<const T&>(notice));
+        });
 }
 
 template <class T>
@@ -246,46 +910,7 @@ DispatcherPtr Broker::_AddDispatcher()
 template <class T>
 void Broker::AddDispatcher()
 {
-    const auto& dispatcher = _AddDispatcher<T>();
-    dispatcher->Register();
-}
-
-template <class OutputPtr, class OutputFactory>
-void Broker::_LoadFromPlugins(const PXR_NS::TfType& type)
-{
-    PXR_NAMESPACE_USING_DIRECTIVE
-
-    const PXR_NS::PlugPluginPtr plugin =
-        PXR_NS::PlugRegistry::GetInstance().GetPluginForType(type);
-
-    if (!plugin) {
-        return;
-    }
-
-    if (!plugin->Load()) {
-        TF_CODING_ERROR(
-            "Failed to load plugin %s for %s",
-            plugin->GetName().c_str(),
-            type.GetTypeName().c_str());
-        return;
-    }
-
-    OutputPtr output;
-    OutputFactory* factory = type.GetFactory<OutputFactory>();
-
-    if (factory) {
-        output = factory->New(TfCreateWeakPtr(this));
-    }
-
-    if (!output) {
-        TF_CODING_ERROR(
-            "Failed to manufacture %s from plugin %s",
-            type.GetTypeName().c_str(),
-            plugin->GetName().c_str());
-        return;
-    }
-
-    _Add(output);
+    _Register(_AddDispatcher<T>());
 }
 
 }  // namespace unf
@@ -1,24 +1,71 @@
 #include "unf/capturePredicate.h"
 
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
 #include <algorithm>
 #include <functional>
 #include <string>
 #include <typeinfo>
 #include <vector>
 
+PXR_NAMESPACE_USING_DIRECTIVE
+
 namespace unf {
 
+namespace {
+
+// Indicate whether type is derived from one of types.
+bool _IsA(const TfType& type, const std::vector<TfType>& types)
+{
+    return std::any_of(types.begin(), types.end(), [&](const TfType& t) {
+        return type.IsA(t);
+    });
+}
+
+}  // anonymous namespace
+
 CapturePredicate::CapturePredicate(const CapturePredicateFunc& function)
     : _function(function)
 {
 }
 
+CapturePredicate::CapturePredicate(
+    const CapturePredicateFunc& function, const CapturePreFilterFunc& preFilter)
+    : _function(function), _preFilter(preFilter)
+{
+}
+
+CapturePredicate::CapturePredicate(
+    const CapturePredicateFunc& function,
+    const CapturePreFilterFunc& preFilter,
+    const CaptureTrimFunc& trim)
+    : _function(function), _preFilter(preFilter), _trim(trim)
+{
+}
+
 bool CapturePredicate::operator()(const UnfNotice::StageNotice& notice) const
 {
     if (!_function) return true;
     return _function(notice);
 }
 
+bool CapturePredicate::Accepts(
+    const TfNotice& notice, const TfType& type) const
+{
+    if (!_preFilter) return true;
+    return _preFilter(notice, type);
+}
+
+bool CapturePredicate::Trim(UnfNotice::StageNotice& notice) const
+{
+    if (!_trim) return true;
+    return _trim(notice);
+}
+
 CapturePredicate CapturePredicate::Default()
 {
     auto function = [](const UnfNotice::StageNotice&) { return true; };
@@ -28,7 +75,44 @@ CapturePredicate CapturePredicate::Default()
 CapturePredicate CapturePredicate::BlockAll()
 {
     auto function = [](const UnfNotice::StageNotice&) { return false; };
-    return CapturePredicate(function);
+    auto preFilter = [](const TfNotice&, const TfType&) { return false; };
+    return CapturePredicate(function, preFilter);
+}
+
+CapturePredicate CapturePredicate::AllowTypes(const std::vector<TfType>& types)
+{
+    auto function = [=](const UnfNotice::StageNotice& notice) {
+        return _IsA(TfType::Find(typeid(notice)), types);
+    };
+    auto preFilter = [=](const TfNotice&, const TfType& type) {
+        return _IsA(type, types);
+    };
+    return CapturePredicate(function, preFilter);
+}
+
+CapturePredicate CapturePredicate::BlockTypes(const std::vector<TfType>& types)
+{
+    auto function = [=](const UnfNotice::StageNotice& notice) {
+        return !_IsA(TfType::Find(typeid(notice)), types);
+    };
+    auto preFilter = [=](const TfNotice&, const TfType& type) {
+        return !_IsA(type, types);
+    };
+    return CapturePredicate(function, preFilter);
+}
+
+CapturePredicate CapturePredicate::Trimming(
+    const SdfPathVector& subtrees, const TfTokenVector& ignoredFields)
+{
+    const TfTokenSet fields(ignoredFields.begin(), ignoredFields.end());
+
+    auto trim = [=](UnfNotice::StageNotice& notice) {
+        auto* _notice = dynamic_cast<UnfNotice::ObjectsChanged*>(&notice);
+        if (!_notice) return true;
+
+        return _notice->Trim(subtrees, fields);
+    };
+    return CapturePredicate(nullptr, nullptr, trim);
 }
 
 }  // namespace unf
@@ -6,6 +6,11 @@
 #include "unf/api.h"
 #include "unf/notice.h"
 
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
 #include <functional>
 #include <string>
 #include <vector>
@@ -15,6 +20,22 @@ namespace unf {
 /// Convenient alias for function defining whether notice can be captured.
 using CapturePredicateFunc = std::function<bool(const UnfNotice::StageNotice&)>;
 
+/// \brief
+/// Convenient alias for function defining whether a notice can be captured
+/// before it is created from an incoming notice.
+///
+/// The function receives the incoming notice and the type of the standalone
+/// notice which would be created from it.
+using CapturePreFilterFunc =
+    std::function<bool(const PXR_NS::TfNotice&, const PXR_NS::TfType&)>;
+
+/// \brief
+/// Convenient alias for function removing content from a notice before it is
+/// captured.
+///
+/// The function returns false if the notice should be dropped.
+using CaptureTrimFunc = std::function<bool(UnfNotice::StageNotice&)>;
+
 /// \class CapturePredicate
 ///
 /// \brief
@@ -41,17 +62,106 @@ class CapturePredicate {
     /// \endcode
     UNF_API CapturePredicate(const CapturePredicateFunc&);
 
+    /// \brief
+    /// Create predicate from a \p function and a \p preFilter function.
+    ///
+    /// The \p preFilter function is evaluated by dispatchers before a
+    /// standalone notice is created from an incoming notice, so that notices
+    /// dropped by the transaction are never created. The following example
+    /// will skip the conversion of PXR_NS::UsdNotice::ObjectsChanged notices
+    /// holding more than 1000 resynced paths.
+    ///
+    /// \code{.cpp}
+    /// CapturePredicate(
+    ///     nullptr,
+    ///     [&](const PXR_NS::TfNotice& n, const PXR_NS::TfType&) {
+    ///         auto* notice =
+    ///             dynamic_cast<const PXR_NS::UsdNotice::ObjectsChanged*>(&n);
+    ///         return !notice || notice->GetResyncedPaths().size() <= 1000;
+    ///     });
+    /// \endcode
+    ///
+    /// The \p function is still evaluated for each notice created.
+    UNF_API CapturePredicate(
+        const CapturePredicateFunc& function,
+        const CapturePreFilterFunc& preFilter);
+
+    /// \brief
+    /// Create predicate from a \p function, a \p preFilter function and a
+    /// \p trim function.
+    ///
+    /// The \p trim function is evaluated for each notice accepted by
+    /// \p function before it is captured. The notice is copied first if it
+    /// is referenced elsewhere.
+    UNF_API CapturePredicate(
+        const CapturePredicateFunc& function,
+        const CapturePreFilterFunc& preFilter,
+        const CaptureTrimFunc& trim);
+
     /// Invoke boolean predicate on UnfNotice::StageNotice \p notice.
     UNF_API bool operator()(const UnfNotice::StageNotice&) const;
 
+    /// Indicate whether the predicate has a trim function.
+    bool HasTrimFunction() const { return static_cast<bool>(_trim); }
+
+    /// \brief
+    /// Remove content from \p notice before it is captured.
+    ///
+    /// Return false if the notice should be dropped. Return true if the
+    /// predicate does not have a trim function.
+    UNF_API bool Trim(UnfNotice::StageNotice& notice) const;
+
+    /// \brief
+    /// Indicate whether a notice of \p type created from the incoming
+    /// \p notice can be captured.
+    ///
+    /// Return true if the predicate does not have a pre-filter function.
+    UNF_API bool Accepts(
+        const PXR_NS::TfNotice& notice, const PXR_NS::TfType& type) const;
+
     /// Create a predicate which return true for each notice type.
     UNF_API static CapturePredicate Default();
 
+    /// \brief
     /// Create a predicate which return false for each notice type.
+    ///
+    /// Incoming notices are not converted into standalone notices.
     UNF_API static CapturePredicate BlockAll();
 
+    /// \brief
+    /// Create a predicate which only return true for notices derived from
+    /// one of \p types.
+    ///
+    /// Incoming notices are only converted into standalone notices derived
+    /// from one of \p types.
+    UNF_API static CapturePredicate AllowTypes(
+        const std::vector<PXR_NS::TfType>& types);
+
+    /// \brief
+    /// Create a predicate which return false for notices derived from one of
+    /// \p types.
+    ///
+    /// Incoming notices are not converted into standalone notices derived
+    /// from one of \p types.
+    UNF_API static CapturePredicate BlockTypes(
+        const std::vector<PXR_NS::TfType>& types);
+
+    /// \brief
+    /// Create a predicate which captures all notices, but removes paths
+    /// outside of \p subtrees and fields within \p ignoredFields from
+    /// UnfNotice::ObjectsChanged notices.
+    ///
+    /// UnfNotice::ObjectsChanged notices left without any path are dropped.
+    ///
+    /// \sa UnfNotice::ObjectsChanged::Trim
+    UNF_API static CapturePredicate Trimming(
+        const PXR_NS::SdfPathVector& subtrees,
+        const PXR_NS::TfTokenVector& ignoredFields);
+
   private:
     CapturePredicateFunc _function = nullptr;
+    CapturePreFilterFunc _preFilter = nullptr;
+    CaptureTrimFunc _trim = nullptr;
 };
 
 }  // namespace unf
@@ -0,0 +1,116 @@
+#include "unf/changeTracker.h"
+#include "unf/broker.h"
+#include "unf/notice.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/mallocTag.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
+
+#include <algorithm>
+#include <cstdint>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+ChangeTracker::ChangeTracker(const BrokerWeakPtr& broker)
+{
+    if (!broker) {
+        TF_CODING_ERROR("Invalid broker.");
+        return;
+    }
+
+    _subscription = broker->Subscribe<UnfNotice::ObjectsChanged>(
+        [this](const UnfNotice::ObjectsChanged& notice) { Update(notice); });
+
+    // Consolidated notices are only emitted within a composite notice when
+    // the broker uses CommitDelivery::Composite.
+    _commitSubscription = broker->Subscribe<UnfNotice::TransactionCommitted>(
+        [this, broker](const UnfNotice::TransactionCommitted& notice) {
+            if (!broker || broker->GetCommitDelivery()
+                               != Broker::CommitDelivery::Composite) {
+                return;
+            }
+
+            for (const auto& _notice : notice.GetNotices()) {
+                const auto* objectsChanged =
+                    dynamic_cast<const UnfNotice::ObjectsChanged*>(
+                        get_pointer(_notice));
+                if (objectsChanged) Update(*objectsChanged);
+            }
+        });
+}
+
+bool ChangeTracker::ChangedSince(
+    const SdfPath& path, uint64_t generation) const
+{
+    if (generation < _compactedGeneration) return true;
+    if (generation >= _generation) return false;
+
+    auto it = _stamps.find(path);
+    if (it != _stamps.end() && it->second.changed > generation) return true;
+
+    for (SdfPath p = path; !p.IsEmpty(); p = p.GetParentPath()) {
+        if (p != path) it = _stamps.find(p);
+        if (it != _stamps.end() && it->second.resynced > generation) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ChangeTracker::Compact(uint64_t generation)
+{
+    TfAutoMallocTag tag("unf", "ChangeTracker::Compact");
+
+    generation = std::min(generation, _generation);
+    if (generation <= _compactedGeneration) return;
+
+    SdfPathTable<_Stamp> stamps;
+    for (const auto& entry : _stamps) {
+        if (entry.second.changed > generation
+            || entry.second.resynced > generation) {
+            stamps[entry.first] = entry.second;
+        }
+    }
+
+    _stamps.swap(stamps);
+    _compactedGeneration = generation;
+}
+
+void ChangeTracker::Update(const UnfNotice::ObjectsChanged& notice)
+{
+    TfAutoMallocTag tag("unf", "ChangeTracker::Update");
+
+    _generation++;
+
+    for (const auto& path : notice.GetResyncedPaths()) {
+        // Stamps of descendants are superseded by the resync.
+        _stamps.erase(path);
+
+        auto& stamp = _stamps[path];
+        stamp.changed = _generation;
+        stamp.resynced = _generation;
+
+        if (path.IsPropertyPath()) _StampChanged(path.GetPrimPath());
+    }
+
+    for (const auto& path : notice.GetChangedInfoOnlyPaths()) {
+        _StampChanged(path);
+    }
+}
+
+void ChangeTracker::_StampChanged(const SdfPath& path)
+{
+    _stamps[path].changed = _generation;
+
+    const SdfPath primPath = path.GetPrimPath();
+    if (primPath != path && !primPath.IsEmpty()) {
+        _stamps[primPath].changed = _generation;
+    }
+}
+
+}  // namespace unf
@@ -0,0 +1,115 @@
+#ifndef USD_NOTICE_FRAMEWORK_CHANGE_TRACKER_H
+#define USD_NOTICE_FRAMEWORK_CHANGE_TRACKER_H
+
+/// \file unf/changeTracker.h
+
+#include "unf/api.h"
+#include "unf/broker.h"
+#include "unf/notice.h"
+
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
+
+#include <cstdint>
+
+namespace unf {
+
+/// \class ChangeTracker
+///
+/// \brief
+/// Record generation at which each path was changed, so that caches can
+/// query whether a path changed since they last looked.
+///
+/// The tracker subscribes to the UnfNotice::ObjectsChanged notices emitted
+/// by a Broker, and increments its generation for each notice received.
+/// Each path resynced or modified is stamped with the new generation:
+///
+/// - Resyncs are inherited by all descendants of the path.
+/// - Paths modified are also stamped on their owning prim, so that a prim is
+///   considered as changed when one of its properties changed.
+///
+/// \code{.cpp}
+/// unf::ChangeTracker tracker(broker);
+///
+/// uint64_t generation = tracker.GetGeneration();
+///
+/// // Later...
+/// if (tracker.ChangedSince(path, generation)) {
+///     // Update cache...
+/// }
+/// \endcode
+///
+/// Only paths which changed are recorded, and stamps held by descendants of
+/// a resynced path are discarded, so the memory used depends on the number
+/// of changes rather than the size of the stage.
+///
+/// \warning
+/// The tracker can be queried from several threads, but not while the
+/// broker emits notices.
+class ChangeTracker {
+  public:
+    /// Start tracking changes emitted by \p broker.
+    UNF_API explicit ChangeTracker(const BrokerWeakPtr& broker);
+
+    /// Remove default copy constructor.
+    ChangeTracker(const ChangeTracker&) = delete;
+
+    /// Remove default assignment operator.
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    /// \brief
+    /// Return current generation.
+    ///
+    /// The generation starts at zero and is incremented for each
+    /// UnfNotice::ObjectsChanged notice received.
+    uint64_t GetGeneration() const { return _generation; }
+
+    /// \brief
+    /// Indicate whether \p path changed after \p generation.
+    ///
+    /// A path changed if it was modified or resynced, or if one of its
+    /// ancestors was resynced. The complexity is linear in the depth of
+    /// the path.
+    ///
+    /// Return true if \p generation is older than the generation of the
+    /// latest call to Compact.
+    UNF_API bool ChangedSince(
+        const PXR_NS::SdfPath& path, uint64_t generation) const;
+
+    /// \brief
+    /// Discard stamps which are not more recent than \p generation.
+    ///
+    /// Queries with an older generation conservatively report all paths as
+    /// changed afterwards.
+    UNF_API void Compact(uint64_t generation);
+
+    /// Return number of paths recorded, including their ancestors.
+    size_t GetSize() const { return _stamps.size(); }
+
+    /// Apply changes from \p notice and increment generation.
+    UNF_API void Update(const UnfNotice::ObjectsChanged& notice);
+
+  private:
+    struct _Stamp {
+        /// Generation at which path was modified or resynced.
+        uint64_t changed = 0;
+
+        /// Generation at which path was resynced.
+        uint64_t resynced = 0;
+    };
+
+    /// Stamp path and its owning prim as changed at current generation.
+    void _StampChanged(const PXR_NS::SdfPath& path);
+
+    PXR_NS::SdfPathTable<_Stamp> _stamps;
+    uint64_t _generation = 0;
+    uint64_t _compactedGeneration = 0;
+
+    Subscription _subscription;
+    Subscription _commitSubscription;
+};
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_CHANGE_TRACKER_H
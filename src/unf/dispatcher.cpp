@@ -2,16 +2,25 @@
 #include "unf/broker.h"
 #include "unf/notice.h"
 
+#include <pxr/base/tf/mallocTag.h>
 #include <pxr/base/tf/weakPtr.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/stage.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace unf {
 
-TF_REGISTRY_FUNCTION(TfType) { TfType::Define<Dispatcher>(); }
+TF_REGISTRY_FUNCTION(TfType)
+{
+    TfType::Define<Dispatcher>();
+
+    DispatcherDefine<LayerDispatcher, Dispatcher>();
+}
 
 Dispatcher::Dispatcher(const BrokerWeakPtr& broker) : _broker(broker) {}
 
@@ -20,6 +29,7 @@ void Dispatcher::Revoke()
     for (auto& key : _keys) {
         TfNotice::Revoke(key);
     }
+    _keys.clear();
 }
 
 StageDispatcher::StageDispatcher(const BrokerWeakPtr& broker)
@@ -41,4 +51,39 @@ void StageDispatcher::Register()
     _Register<UsdNotice::LayerMutingChanged, UnfNotice::LayerMutingChanged>();
 }
 
+LayerDispatcher::LayerDispatcher(const BrokerWeakPtr& broker)
+    : Dispatcher(broker)
+{
+}
+
+void LayerDispatcher::Register()
+{
+    if (!_broker->IsRequested(TfType::Find<UnfNotice::LayersChanged>())) {
+        return;
+    }
+
+    // Layer notices are not sent by the stage, so the listener is
+    // registered for all senders.
+    auto self = TfCreateWeakPtr(this);
+    _keys.push_back(TfNotice::Register(self, &LayerDispatcher::_OnReceiving));
+}
+
+void LayerDispatcher::_OnReceiving(const SdfNotice::LayersDidChange& notice)
+{
+    const auto& stage = _broker->GetStage();
+    if (!stage) return;
+
+    static const auto type = TfType::Find<UnfNotice::LayersChanged>();
+    if (!_broker->Accepts(notice, type)) return;
+
+    const SdfLayerHandleVector usedLayers = stage->GetUsedLayers(false);
+    const SdfLayerHandleSet layers(usedLayers.begin(), usedLayers.end());
+
+    TfAutoMallocTag tag("unf", "LayerDispatcher::_OnReceiving");
+    auto _notice = UnfNotice::LayersChanged::Create(notice, layers);
+    if (_notice->GetChangedFieldMap().empty()) return;
+
+    _broker->Send(std::move(_notice));
+}
+
 }  // namespace unf
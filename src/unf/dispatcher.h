@@ -6,11 +6,13 @@
 #include "unf/broker.h"
 #include "unf/notice.h"
 
+#include <pxr/base/tf/mallocTag.h>
 #include <pxr/base/tf/refBase.h>
 #include <pxr/base/tf/refPtr.h>
 #include <pxr/base/tf/type.h>
 #include <pxr/base/tf/weakBase.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/usd/common.h>
 
 namespace unf {
@@ -34,7 +36,13 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// Broker::GetDispatcher
     UNF_API virtual std::string GetIdentifier() const = 0;
 
-    ///  Register listeners to PXR_NS::TfNotice derived notices.
+    /// \brief
+    /// Register listeners to PXR_NS::TfNotice derived notices.
+    ///
+    /// This method can be called again after Revoke when the notices
+    /// requested by the broker change.
+    ///
+    /// \sa Broker::SetLazyRegistration
     UNF_API virtual void Register() = 0;
 
     /// Revoke all registered listeners.
@@ -57,13 +65,22 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     ///     UnfNotice::ObjectsChanged>();
     /// \endcode
     ///
+    /// The listener is not registered if \p OutputNotice is not requested
+    /// by the broker.
+    ///
     /// \warning
     /// The \p OutputNotice notice must be derived from
     /// UnfNotice::StageNotice and must have a constructor which takes an
     /// instance of \p InputNotice.
+    ///
+    /// \sa Broker::SetLazyRegistration
     template <class InputNotice, class OutputNotice>
     void _Register()
     {
+        if (!_broker->IsRequested(PXR_NS::TfType::Find<OutputNotice>())) {
+            return;
+        }
+
         auto self = PXR_NS::TfCreateWeakPtr(this);
         auto cb = &Dispatcher::_OnReceiving<InputNotice, OutputNotice>;
         _keys.push_back(
@@ -74,6 +91,11 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     /// Convenient templated method to emit a \p OutputNotice notice from an
     /// incoming \p InputNotice notice.
     ///
+    /// The notice is not created if the current transaction would not
+    /// capture it.
+    ///
+    /// \sa Broker::Accepts
+    ///
     /// \warning
     /// The \p OutputNotice notice must be derived from
     /// UnfNotice::StageNotice and must have a constructor which takes an
@@ -81,8 +103,15 @@ class Dispatcher : public PXR_NS::TfRefBase, public PXR_NS::TfWeakBase {
     template <class InputNotice, class OutputNotice>
     void _OnReceiving(const InputNotice& notice)
     {
+        // Skip conversion if the notice would be dropped by the transaction.
+        static const auto type = PXR_NS::TfType::Find<OutputNotice>();
+        if (!_broker->Accepts(notice, type)) return;
+
+        PXR_NS::TfAutoMallocTag tag("unf", "Dispatcher::_OnReceiving");
         PXR_NS::TfRefPtr<OutputNotice> _notice = OutputNotice::Create(notice);
-        _broker->Send(_notice);
+
+        // Move notice so that the broker holds the only reference to it.
+        _broker->Send(std::move(_notice));
     }
 
     /// Broker that the dispatcher is attached to.
@@ -169,6 +198,42 @@ void DispatcherDefine()
         .template SetFactory<DispatcherFactoryImpl<T> >();
 }
 
+/// \class LayerDispatcher
+///
+/// \brief
+/// Dispatcher which emits UnfNotice::LayersChanged notices corresponding to
+/// each PXR_NS::SdfNotice::LayersDidChange notice affecting layers used by
+/// the stage.
+///
+/// This dispatcher is not added to the Broker by default. It can be added
+/// explicitly or discovered as a plugin:
+///
+/// \code{.cpp}
+/// broker->AddDispatcher<unf::LayerDispatcher>();
+/// \endcode
+class LayerDispatcher : public Dispatcher {
+  public:
+    virtual std::string GetIdentifier() const override
+    {
+        return "LayerDispatcher";
+    }
+
+    /// Register listener to PXR_NS::SdfNotice::LayersDidChange notices.
+    UNF_API virtual void Register() override;
+
+  private:
+    UNF_API LayerDispatcher(const BrokerWeakPtr& broker);
+
+    /// \brief
+    /// Emit a UnfNotice::LayersChanged notice if \p notice affects
+    /// any layer used by the stage.
+    void _OnReceiving(const PXR_NS::SdfNotice::LayersDidChange& notice);
+
+    /// Only a Broker or a factory can create a LayerDispatcher.
+    friend class Broker;
+    friend class DispatcherFactoryImpl<LayerDispatcher>;
+};
+
 }  // namespace unf
 
 #endif  // USD_NOTICE_FRAMEWORK_DISPATCHER_H
@@ -0,0 +1,363 @@
+#include "unf/layerDiff.h"
+#include "unf/broker.h"
+#include "unf/notice.h"
+#include "unf/transaction.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/mallocTag.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/sdf/types.h>
+#include <pxr/usd/usd/stage.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+namespace {
+
+// Change detected on a single spec.
+struct _Change {
+    SdfPath path;
+    bool resync;
+    TfTokenVector fields;
+};
+
+// Fields which resync a prim when modified.
+const TfTokenSet& _GetPrimResyncFields()
+{
+    static const TfTokenSet fields = {
+        SdfFieldKeys->Active,
+        SdfFieldKeys->InheritPaths,
+        SdfFieldKeys->Instanceable,
+        SdfFieldKeys->Payload,
+        SdfFieldKeys->PrimOrder,
+        SdfFieldKeys->References,
+        SdfFieldKeys->Specializes,
+        SdfFieldKeys->Specifier,
+        SdfFieldKeys->TypeName,
+        SdfFieldKeys->VariantSelection,
+        SdfFieldKeys->VariantSetNames,
+        TfToken("apiSchemas"),
+    };
+    return fields;
+}
+
+// Fields which resync a property when modified.
+const TfTokenSet& _GetPropertyResyncFields()
+{
+    static const TfTokenSet fields = {
+        SdfFieldKeys->TypeName,
+        SdfFieldKeys->Variability,
+    };
+    return fields;
+}
+
+// Fields which resync the pseudo-root when modified.
+const TfTokenSet& _GetLayerResyncFields()
+{
+    static const TfTokenSet fields = {
+        SdfFieldKeys->SubLayers,
+        SdfFieldKeys->SubLayerOffsets,
+    };
+    return fields;
+}
+
+// Fields listing children specs, which are compared individually.
+const TfTokenSet& _GetChildrenFields()
+{
+    static const TfTokenSet fields(
+        SdfChildrenKeys->allTokens.begin(), SdfChildrenKeys->allTokens.end());
+    return fields;
+}
+
+// Return fields modified on spec at 'path', excluding children fields.
+TfTokenVector _GetChangedFields(
+    const SdfLayerHandle& before,
+    const SdfLayerHandle& after,
+    const SdfPath& path)
+{
+    const auto& childrenFields = _GetChildrenFields();
+
+    TfTokenVector fields;
+
+    const TfTokenVector fieldsBefore = before->ListFields(path);
+    for (const auto& field : fieldsBefore) {
+        if (childrenFields.count(field)) continue;
+
+        if (before->GetField(path, field) != after->GetField(path, field)) {
+            fields.push_back(field);
+        }
+    }
+
+    for (const auto& field : after->ListFields(path)) {
+        if (childrenFields.count(field)) continue;
+
+        const auto it =
+            std::find(fieldsBefore.begin(), fieldsBefore.end(), field);
+        if (it == fieldsBefore.end()) fields.push_back(field);
+    }
+
+    return fields;
+}
+
+// Return prim owning the variant set which contains 'path'.
+SdfPath _GetVariantOwnerPath(SdfPath path)
+{
+    while (path.ContainsPrimVariantSelection()) {
+        path = path.GetParentPath();
+    }
+    return path;
+}
+
+// Return prim or property owning a spec which is neither a prim nor a
+// property (e.g. a relationship target or an attribute connection).
+SdfPath _GetOwnerPath(SdfPath path)
+{
+    while (!path.IsEmpty() && !path.IsPrimPath() && !path.IsPrimPropertyPath()
+           && !path.IsAbsoluteRootPath()) {
+        path = path.GetParentPath();
+    }
+    return path;
+}
+
+// Compare spec at 'path' between both layers and record changes.
+void _Compare(
+    const SdfLayerHandle& before,
+    const SdfLayerHandle& after,
+    const SdfPath& path,
+    std::vector<_Change>& changes)
+{
+    const SdfSpecType typeBefore = before->GetSpecType(path);
+    const SdfSpecType typeAfter = after->GetSpecType(path);
+
+    const bool added = typeBefore == SdfSpecTypeUnknown;
+    const bool removed = typeAfter == SdfSpecTypeUnknown;
+
+    TfTokenVector fields;
+    if (typeBefore == typeAfter) {
+        fields = _GetChangedFields(before, after, path);
+        if (fields.empty()) return;
+    }
+
+    // Changes within variants resync the prim owning the variant set, as
+    // the variant might not be selected.
+    if (path.ContainsPrimVariantSelection()) {
+        changes.push_back({_GetVariantOwnerPath(path), true, {}});
+        return;
+    }
+
+    const SdfSpecType type = added ? typeAfter : typeBefore;
+
+    const TfTokenSet* resyncFields = nullptr;
+    switch (type) {
+        case SdfSpecTypePseudoRoot:
+            resyncFields = &_GetLayerResyncFields();
+            break;
+        case SdfSpecTypePrim:
+            resyncFields = &_GetPrimResyncFields();
+            break;
+        case SdfSpecTypeAttribute:
+        case SdfSpecTypeRelationship:
+            resyncFields = &_GetPropertyResyncFields();
+            break;
+        default:
+            // Other specs modify the prim or property which owns them.
+            changes.push_back({_GetOwnerPath(path), false, {}});
+            return;
+    }
+
+    if (added || removed || typeBefore != typeAfter) {
+        changes.push_back({path, true, {}});
+        return;
+    }
+
+    const bool resync = std::any_of(
+        fields.begin(), fields.end(), [&](const TfToken& field) {
+            return resyncFields->count(field) > 0;
+        });
+
+    changes.push_back({path, resync, std::move(fields)});
+}
+
+// Return all spec paths in 'layer', sorted.
+SdfPathVector _GetSpecPaths(const SdfLayerHandle& layer)
+{
+    SdfPathVector paths;
+    layer->Traverse(SdfPath::AbsoluteRootPath(), [&](const SdfPath& path) {
+        paths.push_back(path);
+    });
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+// Apply 'edit' on 'layer' and emit changes computed with LayerDiff instead
+// of the notice reported by USD.
+bool _EditWithDiff(
+    const BrokerPtr& broker,
+    const SdfLayerHandle& layer,
+    const std::function<bool()>& edit)
+{
+    if (!broker || !layer) {
+        TF_CODING_ERROR("Invalid broker or layer.");
+        return false;
+    }
+
+    const auto stage = broker->GetStage();
+    if (!stage || !stage->HasLocalLayer(layer)) return edit();
+
+    SdfLayerRefPtr snapshot;
+    {
+        TfAutoMallocTag tag("unf", "LayerDiff::Snapshot");
+        snapshot = SdfLayer::CreateAnonymous();
+        snapshot->TransferContent(layer);
+    }
+
+    // Drop the coarse ObjectsChanged notice reported by USD during the edit.
+    bool editing = true;
+    NoticeTransaction transaction(
+        broker, [&](const UnfNotice::StageNotice& notice) {
+            return !editing
+                   || !dynamic_cast<const UnfNotice::ObjectsChanged*>(&notice);
+        });
+
+    const bool result = edit();
+    editing = false;
+
+    if (result) {
+        LayerDiff diff(snapshot, layer);
+        if (!diff.IsEmpty()) broker->Send(diff.CreateNotice());
+    }
+
+    return result;
+}
+
+}  // namespace
+
+LayerDiff::LayerDiff(const SdfLayerHandle& before, const SdfLayerHandle& after)
+{
+    TfAutoMallocTag tag("unf", "LayerDiff");
+
+    if (!before || !after) {
+        TF_CODING_ERROR("Invalid layer.");
+        return;
+    }
+
+    SdfPathVector paths;
+    {
+        const SdfPathVector pathsBefore = _GetSpecPaths(before);
+        const SdfPathVector pathsAfter = _GetSpecPaths(after);
+
+        paths.reserve(std::max(pathsBefore.size(), pathsAfter.size()));
+        std::set_union(
+            pathsBefore.begin(),
+            pathsBefore.end(),
+            pathsAfter.begin(),
+            pathsAfter.end(),
+            std::back_inserter(paths));
+    }
+
+    // Compare specs in parallel, as layers can safely be read from multiple
+    // threads.
+    tbb::enumerable_thread_specific<std::vector<_Change> > threadChanges;
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, paths.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            auto& changes = threadChanges.local();
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                _Compare(before, after, paths[i], changes);
+            }
+        });
+
+    std::set<SdfPath> resynced;
+    std::set<SdfPath> changedInfo;
+    ChangedFieldMap changedFields;
+
+    for (auto& changes : threadChanges) {
+        for (auto& change : changes) {
+            if (change.resync) {
+                resynced.insert(change.path);
+            }
+            else {
+                changedInfo.insert(change.path);
+            }
+
+            if (!change.fields.empty()) {
+                changedFields[change.path].insert(
+                    change.fields.begin(), change.fields.end());
+            }
+        }
+    }
+
+    _resyncChanges.assign(resynced.begin(), resynced.end());
+    SdfPath::RemoveDescendentPaths(&_resyncChanges);
+
+    const SdfPathSet resyncedSet(_resyncChanges.begin(), _resyncChanges.end());
+
+    // Skip changed info within resynced paths.
+    for (const auto& path : changedInfo) {
+        bool isResynced = false;
+        for (SdfPath p = path; !p.IsEmpty(); p = p.GetParentPath()) {
+            if (resyncedSet.count(p)) {
+                isResynced = true;
+                break;
+            }
+        }
+
+        if (!isResynced) _infoChanges.push_back(path);
+    }
+
+    const SdfPathSet infoSet(_infoChanges.begin(), _infoChanges.end());
+
+    for (auto& entry : changedFields) {
+        if (resyncedSet.count(entry.first) || infoSet.count(entry.first)) {
+            _changedFields[entry.first] = std::move(entry.second);
+        }
+    }
+}
+
+TfRefPtr<UnfNotice::ObjectsChanged> LayerDiff::CreateNotice() const
+{
+    return UnfNotice::ObjectsChanged::Create(
+        _resyncChanges, _infoChanges, _changedFields);
+}
+
+bool ReloadLayer(
+    const BrokerPtr& broker, const SdfLayerHandle& layer, bool force)
+{
+    return _EditWithDiff(
+        broker, layer, [&]() { return layer->Reload(force); });
+}
+
+void ReplaceLayerContent(
+    const BrokerPtr& broker,
+    const SdfLayerHandle& layer,
+    const SdfLayerHandle& source)
+{
+    if (!source) {
+        TF_CODING_ERROR("Invalid source layer.");
+        return;
+    }
+
+    _EditWithDiff(broker, layer, [&]() {
+        layer->TransferContent(source);
+        return true;
+    });
+}
+
+}  // namespace unf
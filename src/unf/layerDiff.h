@@ -0,0 +1,108 @@
+#ifndef USD_NOTICE_FRAMEWORK_LAYER_DIFF_H
+#define USD_NOTICE_FRAMEWORK_LAYER_DIFF_H
+
+/// \file unf/layerDiff.h
+
+#include "unf/api.h"
+#include "unf/broker.h"
+#include "unf/notice.h"
+
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+
+namespace unf {
+
+/// \class LayerDiff
+///
+/// \brief
+/// Compare the content of two layers spec by spec.
+///
+/// Changes are classified the same way as PXR_NS::UsdNotice::ObjectsChanged:
+///
+/// - Specs added or removed, and fields affecting composition (e.g.
+///   references, specifier or type name), resync the corresponding path.
+/// - Other fields modified are recorded as changed info on the corresponding
+///   path, with the name of each field modified.
+/// - Changes within variants resync the prim owning the variant set.
+///
+/// Specs are compared in parallel. Paths are expressed in the namespace of
+/// the layers, which matches the namespace of a stage for layers within its
+/// local layer stack.
+class LayerDiff {
+  public:
+    /// Compare content of \p before with content of \p after.
+    UNF_API LayerDiff(
+        const PXR_NS::SdfLayerHandle& before,
+        const PXR_NS::SdfLayerHandle& after);
+
+    /// Indicate whether both layers have the same content.
+    bool IsEmpty() const
+    {
+        return _resyncChanges.empty() && _infoChanges.empty();
+    }
+
+    /// \brief
+    /// Return vector of paths that are resynced in lexicographical order.
+    ///
+    /// Descendants of resynced paths are not included.
+    const PXR_NS::SdfPathVector& GetResyncedPaths() const
+    {
+        return _resyncChanges;
+    }
+
+    /// \brief
+    /// Return vector of paths that are modified but not resynced in
+    /// lexicographical order.
+    const PXR_NS::SdfPathVector& GetChangedInfoOnlyPaths() const
+    {
+        return _infoChanges;
+    }
+
+    /// Return map of changed token sets organized per path.
+    const ChangedFieldMap& GetChangedFieldMap() const { return _changedFields; }
+
+    /// Create UnfNotice::ObjectsChanged notice holding the changes.
+    UNF_API PXR_NS::TfRefPtr<UnfNotice::ObjectsChanged> CreateNotice() const;
+
+  private:
+    PXR_NS::SdfPathVector _resyncChanges;
+    PXR_NS::SdfPathVector _infoChanges;
+    ChangedFieldMap _changedFields;
+};
+
+/// \brief
+/// Reload \p layer and emit a fine-grained UnfNotice::ObjectsChanged notice
+/// via \p broker.
+///
+/// Reloading a layer is reported by USD as a resync of the pseudo-root, which
+/// forces all listeners to rebuild their state. If \p layer is within the
+/// local layer stack of the stage associated with \p broker, the content of
+/// the layer is copied before being reloaded, and the UnfNotice::ObjectsChanged
+/// notice emitted is computed with LayerDiff. Otherwise, the layer is
+/// reloaded with the notice reported by USD.
+///
+/// Return false if the layer could not be reloaded.
+///
+/// \note
+/// Copying the layer content doubles the memory used by the layer for the
+/// duration of the operation.
+UNF_API bool ReloadLayer(
+    const BrokerPtr& broker,
+    const PXR_NS::SdfLayerHandle& layer,
+    bool force = false);
+
+/// \brief
+/// Replace the content of \p layer with the content of \p source and emit a
+/// fine-grained UnfNotice::ObjectsChanged notice via \p broker.
+///
+/// \sa ReloadLayer
+UNF_API void ReplaceLayerContent(
+    const BrokerPtr& broker,
+    const PXR_NS::SdfLayerHandle& layer,
+    const PXR_NS::SdfLayerHandle& source);
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_LAYER_DIFF_H
@@ -1,16 +1,169 @@
 #include "unf/notice.h"
+#include "unf/serialization.h"
 
+#include <pxr/base/tf/mallocTag.h>
 #include <pxr/base/tf/notice.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/pcp/layerStack.h>
+#include <pxr/usd/pcp/node.h>
+#include <pxr/usd/pcp/primIndex.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/layerUtils.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/schema.h>
 #include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usd/stage.h>
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_unordered_map.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace unf {
 
+namespace {
+
+// Return categories of a path modified but not resynced from its changed
+// 'fields'. Changes without fields are considered as metadata changes.
+ChangeCategory _CategorizeFields(const TfTokenSet* fields)
+{
+    if (!fields || fields->empty()) return ChangeCategory::Metadata;
+
+    ChangeCategory category = ChangeCategory::None;
+    for (const auto& field : *fields) {
+        if (field == SdfFieldKeys->Default) {
+            category |= ChangeCategory::Value;
+        }
+        else if (field == SdfFieldKeys->TimeSamples) {
+            category |= ChangeCategory::TimeSamples;
+        }
+        else {
+            category |= ChangeCategory::Metadata;
+        }
+    }
+    return category;
+}
+
+// Minimum number of paths queried per task.
+constexpr size_t _queryGrainSize = 4096;
+
+// Return indices of 'paths' in lexicographical order, or an empty vector if
+// 'paths' are already sorted.
+std::vector<size_t> _GetSortedIndices(const SdfPathVector& paths)
+{
+    std::vector<size_t> indices;
+    if (std::is_sorted(paths.begin(), paths.end())) return indices;
+
+    indices.resize(paths.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    tbb::parallel_sort(
+        indices.begin(), indices.end(), [&](size_t lhs, size_t rhs) {
+            return paths[lhs] < paths[rhs];
+        });
+    return indices;
+}
+
+// Combine into 'result', for each path in 'paths', the 'values' of all
+// 'sources' which are equal to or ancestors of the path. 'sources' must be
+// sorted, and 'indices' must hold the indices of 'paths' in lexicographical
+// order unless 'paths' are sorted.
+//
+// Paths are visited in lexicographical order alongside the sources, while a
+// stack holds the sources which are ancestors of the current path. As
+// descendants of a path are contiguous in lexicographical order, a source
+// popped from the stack cannot be an ancestor of any following path. Ranges
+// of paths are processed in parallel, each starting with the ancestors of
+// its first path.
+void _QueryPrefixes(
+    const SdfPathVector& sources,
+    const std::vector<uint32_t>& values,
+    const SdfPathVector& paths,
+    const std::vector<size_t>& indices,
+    std::vector<uint32_t>& result)
+{
+    if (sources.empty() || paths.empty()) return;
+
+    struct _Entry {
+        const SdfPath* path;
+        uint32_t value;
+    };
+
+    const auto _index = [&](size_t i) {
+        return indices.empty() ? i : indices[i];
+    };
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, paths.size(), _queryGrainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            std::vector<_Entry> stack;
+
+            const SdfPath& first = paths[_index(range.begin())];
+
+            SdfPathVector ancestors;
+            for (SdfPath p = first; !p.IsEmpty(); p = p.GetParentPath()) {
+                ancestors.push_back(p);
+            }
+
+            for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+                auto source =
+                    std::lower_bound(sources.begin(), sources.end(), *it);
+                if (source == sources.end() || *source != *it) continue;
+
+                uint32_t value = stack.empty() ? 0 : stack.back().value;
+                for (; source != sources.end() && *source == *it; ++source) {
+                    value |= values[source - sources.begin()];
+                }
+                stack.push_back({&*it, value});
+            }
+
+            size_t next =
+                std::upper_bound(sources.begin(), sources.end(), first)
+                - sources.begin();
+
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                const size_t index = _index(i);
+                const SdfPath& path = paths[index];
+
+                // Push sources which are not greater than the path.
+                for (; next < sources.size() && !(path < sources[next]);
+                     ++next) {
+                    const SdfPath& source = sources[next];
+                    while (!stack.empty()
+                           && !source.HasPrefix(*stack.back().path)) {
+                        stack.pop_back();
+                    }
+
+                    const uint32_t value =
+                        stack.empty() ? 0 : stack.back().value;
+                    stack.push_back({&source, value | values[next]});
+                }
+
+                while (!stack.empty() && !path.HasPrefix(*stack.back().path)) {
+                    stack.pop_back();
+                }
+
+                if (!stack.empty()) result[index] |= stack.back().value;
+            }
+        });
+}
+
+}  // namespace
+
 namespace UnfNotice {
 
 TF_REGISTRY_FUNCTION(TfType)
@@ -21,6 +174,8 @@ TF_REGISTRY_FUNCTION(TfType)
     TfType::Define<StageEditTargetChanged, TfType::Bases<StageNotice> >();
     TfType::Define<ObjectsChanged, TfType::Bases<StageNotice> >();
     TfType::Define<LayerMutingChanged, TfType::Bases<StageNotice> >();
+    TfType::Define<LayersChanged, TfType::Bases<StageNotice> >();
+    TfType::Define<TransactionCommitted, TfType::Bases<StageNotice> >();
 }
 
 ObjectsChanged::ObjectsChanged(const UsdNotice::ObjectsChanged& notice)
@@ -29,12 +184,28 @@ ObjectsChanged::ObjectsChanged(const UsdNotice::ObjectsChanged& notice)
 
     for (const auto& path : notice.GetResyncedPaths()) {
         _resyncChanges.push_back(path);
+        _changeCategories[path] = ChangeCategory::Structure;
 
         auto tokens = notice.GetChangedFields(path);
         if (tokens.size() > 0) {
             _changedFields[path] = TfTokenSet(tokens.begin(), tokens.end());
         }
     }
+
+    // Paths affected by changes of resolved asset paths are resynced, but
+    // are recorded with a distinct category so that listeners which do not
+    // depend on resolved asset paths can skip them.
+    bool sorted = true;
+    for (const auto& path : notice.GetResolvedAssetPathsResyncedPaths()) {
+        auto& category = _changeCategories[path];
+        if (category == ChangeCategory::None) {
+            _resyncChanges.push_back(path);
+            sorted = false;
+        }
+        category |= ChangeCategory::ResolvedAssetPath;
+    }
+    if (!sorted) std::sort(_resyncChanges.begin(), _resyncChanges.end());
+
     for (const auto& path : notice.GetChangedInfoOnlyPaths()) {
         _infoChanges.push_back(path);
 
@@ -42,27 +213,57 @@ ObjectsChanged::ObjectsChanged(const UsdNotice::ObjectsChanged& notice)
         if (tokens.size() > 0) {
             _changedFields[path] = TfTokenSet(tokens.begin(), tokens.end());
         }
+
+        const auto it = _changedFields.find(path);
+        _changeCategories[path] |= _CategorizeFields(
+            it != _changedFields.end() ? &it->second : nullptr);
     }
+
+    _UpdateCategories();
+}
+
+ObjectsChanged::ObjectsChanged(
+    SdfPathVector resyncedPaths,
+    SdfPathVector changedInfoOnlyPaths,
+    ChangedFieldMap changedFields)
+    : _resyncChanges(std::move(resyncedPaths)),
+      _infoChanges(std::move(changedInfoOnlyPaths)),
+      _changedFields(std::move(changedFields))
+{
+    _Categorize();
 }
 
 ObjectsChanged::ObjectsChanged(const ObjectsChanged& other)
-    : _resyncChanges(other._resyncChanges),
+    : _resyncChanges(other.GetResyncedPaths()),
       _infoChanges(other._infoChanges),
-      _changedFields(other._changedFields)
+      _changedFields(other._changedFields),
+      _changeCategories(other._changeCategories),
+      _categories(other._categories),
+      _coarsened(other._coarsened)
 {
 }
 
+ObjectsChanged::~ObjectsChanged() { _ResetCache(); }
+
 ObjectsChanged& ObjectsChanged::operator=(const ObjectsChanged& other)
 {
     ObjectsChanged copy(other);
     std::swap(_resyncChanges, copy._resyncChanges);
     std::swap(_infoChanges, copy._infoChanges);
     std::swap(_changedFields, copy._changedFields);
+    std::swap(_changeCategories, copy._changeCategories);
+    _categories = copy._categories;
+    _coarsened = copy._coarsened;
+    _postProcess = false;
+    _ResetCache();
     return *this;
 }
 
 void ObjectsChanged::Merge(ObjectsChanged&& notice)
 {
+    _EnsurePostProcessed();
+    notice._EnsurePostProcessed();
+
     // Update resyncChanges if necessary.
     for (auto& path : notice._resyncChanges) {
         const auto iter =
@@ -117,15 +318,262 @@ void ObjectsChanged::Merge(ObjectsChanged&& notice)
                 notice._changedFields[path].end());
         }
     }
+
+    // Update change categories.
+    for (const auto& entry : notice._changeCategories) {
+        _changeCategories[entry.first] |= entry.second;
+    }
+    _categories |= notice._categories;
+
+    _coarsened = _coarsened || notice._coarsened;
+
+    // Derived data must be computed again.
+    _ResetCache();
 }
 
 void ObjectsChanged::PostProcess()
 {
+    // Defer operation until resynced paths are accessed.
+    _postProcess = true;
+    _ResetCache();
+}
+
+void ObjectsChanged::_Categorize()
+{
+    _changeCategories.clear();
+
+    for (const auto& path : _resyncChanges) {
+        _changeCategories[path] = ChangeCategory::Structure;
+    }
+
+    for (const auto& path : _infoChanges) {
+        const auto it = _changedFields.find(path);
+        _changeCategories[path] |= _CategorizeFields(
+            it != _changedFields.end() ? &it->second : nullptr);
+    }
+
+    _UpdateCategories();
+}
+
+void ObjectsChanged::_UpdateCategories()
+{
+    _categories = ChangeCategory::None;
+    for (const auto& entry : _changeCategories) {
+        _categories |= entry.second;
+    }
+}
+
+ChangeCategory ObjectsChanged::GetChangeCategories(const SdfPath& path) const
+{
+    const auto it = _changeCategories.find(path);
+    if (it == _changeCategories.end()) return ChangeCategory::None;
+    return it->second;
+}
+
+void ObjectsChanged::_EnsurePostProcessed() const
+{
+    if (!_postProcess.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> lock(_postProcessMutex);
+    if (!_postProcess.load(std::memory_order_relaxed)) return;
+
     SdfPath::RemoveDescendentPaths(&_resyncChanges);
+    _postProcess.store(false, std::memory_order_release);
+}
+
+ObjectsChanged::_Cache& ObjectsChanged::_GetCache() const
+{
+    _Cache* cache = _cache.load(std::memory_order_acquire);
+    if (cache) return *cache;
+
+    // Only one cache is kept if several threads query the notice at once.
+    auto _newCache = std::make_unique<_Cache>();
+    if (_cache.compare_exchange_strong(
+            cache, _newCache.get(), std::memory_order_acq_rel)) {
+        return *_newCache.release();
+    }
+    return *cache;
+}
+
+void ObjectsChanged::_ResetCache()
+{
+    delete _cache.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+const SdfPathVector& ObjectsChanged::GetResyncedPrimPaths() const
+{
+    _Cache& cache = _GetCache();
+    std::call_once(cache.resyncedPrimPathsFlag, [this, &cache]() {
+        auto& primPaths = cache.resyncedPrimPaths;
+        for (const auto& path : GetResyncedPaths()) {
+            primPaths.push_back(path.GetPrimPath());
+        }
+
+        std::sort(primPaths.begin(), primPaths.end());
+        primPaths.erase(
+            std::unique(primPaths.begin(), primPaths.end()), primPaths.end());
+    });
+
+    return cache.resyncedPrimPaths;
+}
+
+const SdfPathVectorMap& ObjectsChanged::GetChangedPropertiesByPrim() const
+{
+    _Cache& cache = _GetCache();
+    std::call_once(cache.propertiesFlag, [this, &cache]() {
+        auto& properties = cache.properties;
+        for (const auto* paths : {&GetResyncedPaths(), &_infoChanges}) {
+            for (const auto& path : *paths) {
+                if (!path.IsPropertyPath()) continue;
+                properties[path.GetPrimPath()].push_back(path);
+            }
+        }
+
+        for (auto& element : properties) {
+            auto& paths = element.second;
+            std::sort(paths.begin(), paths.end());
+            paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+        }
+    });
+
+    return cache.properties;
+}
+
+const SdfPathVector& ObjectsChanged::GetValueChangedPrimPaths() const
+{
+    _ComputePrimChanges();
+    return _GetCache().valueChangedPrimPaths;
+}
+
+const SdfPathVector& ObjectsChanged::GetMetadataChangedPrimPaths() const
+{
+    _ComputePrimChanges();
+    return _GetCache().metadataChangedPrimPaths;
+}
+
+void ObjectsChanged::_ComputePrimChanges() const
+{
+    _Cache& cache = _GetCache();
+    std::call_once(cache.primChangesFlag, [this, &cache]() {
+        auto& valuePaths = cache.valueChangedPrimPaths;
+        auto& metadataPaths = cache.metadataChangedPrimPaths;
+
+        const ChangeCategory valueCategories =
+            ChangeCategory::Value | ChangeCategory::TimeSamples;
+
+        for (const auto& path : _infoChanges) {
+            const ChangeCategory category = GetChangeCategories(path);
+
+            const bool valueOnly =
+                path.IsPropertyPath() && category != ChangeCategory::None
+                && (category & ~valueCategories) == ChangeCategory::None;
+
+            auto& target = valueOnly ? valuePaths : metadataPaths;
+            target.push_back(path.GetPrimPath());
+        }
+
+        for (auto* paths : {&valuePaths, &metadataPaths}) {
+            std::sort(paths->begin(), paths->end());
+            paths->erase(
+                std::unique(paths->begin(), paths->end()), paths->end());
+        }
+    });
+}
+
+const SdfPathVector& ObjectsChanged::GetAffectedPrimPaths() const
+{
+    _Cache& cache = _GetCache();
+    std::call_once(cache.affectedPrimPathsFlag, [this, &cache]() {
+        auto& primPaths = cache.affectedPrimPaths;
+        for (const auto* paths : {&GetResyncedPaths(), &_infoChanges}) {
+            for (const auto& path : *paths) {
+                primPaths.push_back(path.GetPrimPath());
+            }
+        }
+
+        std::sort(primPaths.begin(), primPaths.end());
+        primPaths.erase(
+            std::unique(primPaths.begin(), primPaths.end()), primPaths.end());
+    });
+
+    return cache.affectedPrimPaths;
+}
+
+std::vector<TfRefPtr<ObjectsChanged> > ObjectsChanged::Split(
+    size_t size) const
+{
+    _EnsurePostProcessed();
+
+    if (size == 0 || _resyncChanges.size() + _infoChanges.size() <= size) {
+        return {Clone()};
+    }
+
+    SdfPathVector resyncPaths(_resyncChanges);
+    std::sort(resyncPaths.begin(), resyncPaths.end());
+
+    SdfPathVector infoPaths(_infoChanges);
+    std::sort(infoPaths.begin(), infoPaths.end());
+
+    const size_t resyncChunks = (resyncPaths.size() + size - 1) / size;
+    const size_t infoChunks = (infoPaths.size() + size - 1) / size;
+
+    std::vector<TfRefPtr<ObjectsChanged> > chunks;
+    chunks.reserve(resyncChunks + infoChunks);
+
+    for (size_t i = 0; i < resyncPaths.size(); i += size) {
+        auto chunk = ObjectsChanged::Create();
+        chunk->_coarsened = _coarsened;
+        const size_t end = std::min(i + size, resyncPaths.size());
+        chunk->_resyncChanges.assign(
+            resyncPaths.begin() + i, resyncPaths.begin() + end);
+        chunks.push_back(chunk);
+    }
+
+    for (size_t i = 0; i < infoPaths.size(); i += size) {
+        auto chunk = ObjectsChanged::Create();
+        chunk->_coarsened = _coarsened;
+        const size_t end = std::min(i + size, infoPaths.size());
+        chunk->_infoChanges.assign(
+            infoPaths.begin() + i, infoPaths.begin() + end);
+        chunks.push_back(chunk);
+    }
+
+    // Return index of the chunk holding the path, or its closest resynced
+    // ancestor. Remaining paths are kept with the first chunk.
+    const auto _chunkIndex = [&](const SdfPath& path) -> size_t {
+        const auto info =
+            std::lower_bound(infoPaths.begin(), infoPaths.end(), path);
+
+        if (info != infoPaths.end() && *info == path) {
+            return resyncChunks + (info - infoPaths.begin()) / size;
+        }
+
+        const auto resync = SdfPathFindLongestPrefix(
+            resyncPaths.begin(), resyncPaths.end(), path);
+        if (resync != resyncPaths.end()) {
+            return (resync - resyncPaths.begin()) / size;
+        }
+
+        return 0;
+    };
+
+    for (const auto& entry : _changedFields) {
+        chunks[_chunkIndex(entry.first)]->_changedFields.insert(entry);
+    }
+
+    for (const auto& entry : _changeCategories) {
+        auto& chunk = chunks[_chunkIndex(entry.first)];
+        chunk->_changeCategories.insert(entry);
+        chunk->_categories |= entry.second;
+    }
+
+    return chunks;
 }
 
 bool ObjectsChanged::ResyncedObject(const PXR_NS::UsdObject& object) const
 {
+    _EnsurePostProcessed();
+
     auto path = PXR_NS::SdfPathFindLongestPrefix(
         _resyncChanges.begin(), _resyncChanges.end(), object.GetPath());
     return path != _resyncChanges.end();
@@ -166,8 +614,508 @@ bool ObjectsChanged::HasChangedFields(const SdfPath& path) const
     return false;
 }
 
+std::vector<bool> ObjectsChanged::QueryResynced(
+    const SdfPathVector& paths) const
+{
+    const auto& sources = _GetSortedResyncedPaths();
+
+    std::vector<uint32_t> result(paths.size(), 0);
+    _QueryPrefixes(
+        sources,
+        std::vector<uint32_t>(sources.size(), 1),
+        paths,
+        _GetSortedIndices(paths),
+        result);
+
+    return std::vector<bool>(result.begin(), result.end());
+}
+
+std::vector<bool> ObjectsChanged::QueryChangedInfoOnly(
+    const SdfPathVector& paths) const
+{
+    const auto& sources = _GetSortedChangedInfoOnlyPaths();
+
+    std::vector<uint32_t> result(paths.size(), 0);
+    _QueryPrefixes(
+        sources,
+        std::vector<uint32_t>(sources.size(), 1),
+        paths,
+        _GetSortedIndices(paths),
+        result);
+
+    return std::vector<bool>(result.begin(), result.end());
+}
+
+std::vector<bool> ObjectsChanged::QueryAffected(
+    const SdfPathVector& paths) const
+{
+    const auto indices = _GetSortedIndices(paths);
+
+    std::vector<uint32_t> result(paths.size(), 0);
+    for (const auto* sources :
+         {&_GetSortedResyncedPaths(), &_GetSortedChangedInfoOnlyPaths()}) {
+        _QueryPrefixes(
+            *sources,
+            std::vector<uint32_t>(sources->size(), 1),
+            paths,
+            indices,
+            result);
+    }
+
+    return std::vector<bool>(result.begin(), result.end());
+}
+
+std::vector<bool> ObjectsChanged::QueryHasChangedFields(
+    const SdfPathVector& paths) const
+{
+    // Changed fields are only recorded on exact paths, so each path is
+    // looked up in the map directly.
+    std::vector<uint8_t> result(paths.size(), 0);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, paths.size(), _queryGrainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                result[i] = _changedFields.count(paths[i]) > 0;
+            }
+        });
+
+    return std::vector<bool>(result.begin(), result.end());
+}
+
+std::vector<ChangeCategory> ObjectsChanged::QueryChangeCategories(
+    const SdfPathVector& paths) const
+{
+    const auto indices = _GetSortedIndices(paths);
+
+    std::vector<uint32_t> result(paths.size(), 0);
+    for (const auto* sources :
+         {&_GetSortedResyncedPaths(), &_GetSortedChangedInfoOnlyPaths()}) {
+        std::vector<uint32_t> values;
+        values.reserve(sources->size());
+        for (const auto& path : *sources) {
+            values.push_back(
+                static_cast<uint32_t>(GetChangeCategories(path)));
+        }
+
+        _QueryPrefixes(*sources, values, paths, indices, result);
+    }
+
+    std::vector<ChangeCategory> categories;
+    categories.reserve(result.size());
+    for (uint32_t value : result) {
+        categories.push_back(static_cast<ChangeCategory>(value));
+    }
+    return categories;
+}
+
+const SdfPathVector& ObjectsChanged::_GetSortedResyncedPaths() const
+{
+    const auto& paths = GetResyncedPaths();
+
+    _Cache& cache = _GetCache();
+    std::call_once(cache.sortedResyncPathsFlag, [&]() {
+        if (std::is_sorted(paths.begin(), paths.end())) return;
+
+        auto& sorted = cache.sortedResyncPaths;
+        sorted = paths;
+        std::sort(sorted.begin(), sorted.end());
+    });
+
+    const auto& sorted = cache.sortedResyncPaths;
+    return sorted.empty() ? paths : sorted;
+}
+
+const SdfPathVector& ObjectsChanged::_GetSortedChangedInfoOnlyPaths() const
+{
+    _Cache& cache = _GetCache();
+    std::call_once(cache.sortedInfoPathsFlag, [this, &cache]() {
+        if (std::is_sorted(_infoChanges.begin(), _infoChanges.end())) return;
+
+        auto& sorted = cache.sortedInfoPaths;
+        sorted = _infoChanges;
+        std::sort(sorted.begin(), sorted.end());
+    });
+
+    const auto& sorted = cache.sortedInfoPaths;
+    return sorted.empty() ? _infoChanges : sorted;
+}
+
+bool ObjectsChanged::Serialize(NoticeWriter& writer) const
+{
+    writer.WritePaths(GetResyncedPaths());
+    writer.WritePaths(_infoChanges);
+
+    // Changed fields are written following the order of the path table.
+    SdfPathVector paths;
+    paths.reserve(_changedFields.size());
+    for (const auto& entry : _changedFields) {
+        paths.push_back(entry.first);
+    }
+    NoticeWriter::SortPaths(&paths);
+    writer.WritePaths(paths);
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> tokens;
+    offsets.reserve(paths.size() + 1);
+
+    for (const auto& path : paths) {
+        offsets.push_back(static_cast<uint32_t>(tokens.size()));
+        for (const auto& token : _changedFields.at(path)) {
+            tokens.push_back(writer.GetTokenIndex(token));
+        }
+    }
+    offsets.push_back(static_cast<uint32_t>(tokens.size()));
+
+    writer.WriteUInt32Array(offsets);
+    writer.WriteUInt32Array(tokens);
+
+    // Change categories are written following the order of the path table.
+    paths.clear();
+    paths.reserve(_changeCategories.size());
+    for (const auto& entry : _changeCategories) {
+        paths.push_back(entry.first);
+    }
+    NoticeWriter::SortPaths(&paths);
+    writer.WritePaths(paths);
+
+    std::vector<uint32_t> categories;
+    categories.reserve(paths.size());
+    for (const auto& path : paths) {
+        categories.push_back(
+            static_cast<uint32_t>(_changeCategories.at(path)));
+    }
+    writer.WriteUInt32Array(categories);
+    return true;
+}
+
+bool ObjectsChanged::Coarsen(const CoarseningPolicy& policy)
+{
+    _EnsurePostProcessed();
+
+    if (!policy.IsEnabled()) return false;
+
+    const SdfPath& root = SdfPath::AbsoluteRootPath();
+    bool coarsened = false;
+
+    // Replace changes on more than 'maxChildren' children by a resync of
+    // their parent, until no prim has too many changed children.
+    while (policy.maxChildren > 0) {
+        std::unordered_map<SdfPath, SdfPathSet, SdfPath::Hash> children;
+        for (const auto* paths : {&_resyncChanges, &_infoChanges}) {
+            for (const auto& path : *paths) {
+                const SdfPath primPath = path.GetPrimPath();
+                if (primPath == root) continue;
+                children[primPath.GetParentPath()].insert(primPath);
+            }
+        }
+
+        SdfPathSet parents;
+        for (const auto& element : children) {
+            if (element.second.size() <= policy.maxChildren) continue;
+            if (element.first == root && !policy.collapseToRoot) continue;
+            parents.insert(element.first);
+        }
+
+        if (parents.empty()) break;
+
+        _Collapse(parents);
+        coarsened = true;
+    }
+
+    // Replace deepest changes by a resync of their parent until the number
+    // of paths fits within 'maxPaths'.
+    while (policy.maxPaths > 0
+           && _resyncChanges.size() + _infoChanges.size() > policy.maxPaths) {
+        size_t depth = 0;
+        for (const auto* paths : {&_resyncChanges, &_infoChanges}) {
+            for (const auto& path : *paths) {
+                depth = std::max(
+                    depth, path.GetPrimPath().GetPathElementCount());
+            }
+        }
+
+        // All changes are on root prims.
+        if (depth <= 1) {
+            if (!policy.collapseToRoot) break;
+
+            _Collapse({root});
+            coarsened = true;
+            break;
+        }
+
+        SdfPathSet parents;
+        for (const auto* paths : {&_resyncChanges, &_infoChanges}) {
+            for (const auto& path : *paths) {
+                const SdfPath primPath = path.GetPrimPath();
+                if (primPath.GetPathElementCount() != depth) continue;
+                parents.insert(primPath.GetParentPath());
+            }
+        }
+
+        _Collapse(parents);
+        coarsened = true;
+    }
+
+    if (coarsened) {
+        // Restore lexicographical order of resynced paths, as collapsed
+        // prims are appended.
+        SdfPath::RemoveDescendentPaths(&_resyncChanges);
+
+        _coarsened = true;
+        _UpdateCategories();
+        _ResetCache();
+    }
+
+    return coarsened;
+}
+
+void ObjectsChanged::_Collapse(const SdfPathSet& prims)
+{
+    // Indicate whether path is equal to or within one of the prims.
+    const auto _isCollapsed = [&](const SdfPath& path) {
+        for (SdfPath prefix = path.GetPrimPath(); !prefix.IsEmpty();
+             prefix = prefix.GetParentPath()) {
+            if (prims.count(prefix)) return true;
+        }
+        return false;
+    };
+
+    for (auto* paths : {&_resyncChanges, &_infoChanges}) {
+        paths->erase(
+            std::remove_if(
+                paths->begin(),
+                paths->end(),
+                [&](const SdfPath& path) {
+                    if (!_isCollapsed(path)) return false;
+                    _changedFields.erase(path);
+                    _changeCategories.erase(path);
+                    return true;
+                }),
+            paths->end());
+    }
+
+    // Prims are resynced without any specific field.
+    SdfPathVector resyncPaths(prims.begin(), prims.end());
+    SdfPath::RemoveDescendentPaths(&resyncPaths);
+    _resyncChanges.insert(
+        _resyncChanges.end(), resyncPaths.begin(), resyncPaths.end());
+
+    for (const auto& path : resyncPaths) {
+        _changeCategories[path] |= ChangeCategory::Structure;
+    }
+}
+
+bool ObjectsChanged::Trim(
+    const SdfPathVector& subtrees, const TfTokenSet& ignoredFields)
+{
+    _EnsurePostProcessed();
+
+    const auto _inSubtrees = [&](const SdfPath& path, bool ancestors) {
+        if (subtrees.empty()) return true;
+
+        for (const auto& root : subtrees) {
+            if (path.HasPrefix(root)) return true;
+            if (ancestors && root.HasPrefix(path)) return true;
+        }
+        return false;
+    };
+
+    // Remove ignored fields and return whether all fields were ignored.
+    const auto _trimFields = [&](const SdfPath& path) {
+        auto it = _changedFields.find(path);
+        if (it == _changedFields.end()) return false;
+        if (ignoredFields.empty()) return false;
+
+        auto& tokens = it->second;
+        for (auto token = tokens.begin(); token != tokens.end();) {
+            if (ignoredFields.count(*token)) {
+                token = tokens.erase(token);
+            }
+            else {
+                ++token;
+            }
+        }
+
+        if (!tokens.empty()) return false;
+
+        _changedFields.erase(it);
+        return true;
+    };
+
+    const auto _remove = [&](SdfPathVector& paths, auto predicate) {
+        paths.erase(
+            std::remove_if(paths.begin(), paths.end(), predicate),
+            paths.end());
+    };
+
+    _remove(_resyncChanges, [&](const SdfPath& path) {
+        if (_inSubtrees(path, true)) {
+            _trimFields(path);
+            return false;
+        }
+        _changedFields.erase(path);
+        _changeCategories.erase(path);
+        return true;
+    });
+
+    _remove(_infoChanges, [&](const SdfPath& path) {
+        if (_inSubtrees(path, false) && !_trimFields(path)) {
+            // Categories of remaining fields only.
+            const auto it = _changedFields.find(path);
+            if (it != _changedFields.end()) {
+                auto& category = _changeCategories[path];
+                category = (category & ChangeCategory::Structure)
+                           | _CategorizeFields(&it->second);
+            }
+            return false;
+        }
+        _changedFields.erase(path);
+        _changeCategories.erase(path);
+        return true;
+    });
+
+    _UpdateCategories();
+    _ResetCache();
+
+    return !_resyncChanges.empty() || !_infoChanges.empty();
+}
+
+size_t ObjectsChanged::GetMemoryUsage() const
+{
+    // Node based containers are estimated with one node per element, holding
+    // the element and a pointer to the next node, and one pointer per bucket.
+    const auto _pathsSize = [](const SdfPathVector& paths) {
+        return paths.capacity() * sizeof(SdfPath);
+    };
+    const auto _nodeSize = [](size_t elementSize) {
+        return elementSize + sizeof(void*) * 2;
+    };
+
+    size_t size = sizeof(*this);
+    size += _pathsSize(_resyncChanges);
+    size += _pathsSize(_infoChanges);
+
+    size += _changedFields.bucket_count() * sizeof(void*);
+    for (const auto& entry : _changedFields) {
+        size += _nodeSize(sizeof(entry));
+        size += entry.second.bucket_count() * sizeof(void*);
+        size += entry.second.size() * _nodeSize(sizeof(TfToken));
+    }
+
+    size += _changeCategories.bucket_count() * sizeof(void*);
+    size += _changeCategories.size()
+            * _nodeSize(sizeof(ChangeCategoryMap::value_type));
+
+    // Derived data is only allocated once queried.
+    const _Cache* cache = _cache.load(std::memory_order_acquire);
+    if (cache) {
+        size += sizeof(_Cache);
+        size += _pathsSize(cache->resyncedPrimPaths);
+        size += _pathsSize(cache->valueChangedPrimPaths);
+        size += _pathsSize(cache->metadataChangedPrimPaths);
+        size += _pathsSize(cache->affectedPrimPaths);
+        size += _pathsSize(cache->sortedResyncPaths);
+        size += _pathsSize(cache->sortedInfoPaths);
+
+        size += cache->properties.bucket_count() * sizeof(void*);
+        for (const auto& entry : cache->properties) {
+            size += _nodeSize(sizeof(entry));
+            size += _pathsSize(entry.second);
+        }
+    }
+
+    return size;
+}
+
+TfRefPtr<ObjectsChanged> ObjectsChanged::Deserialize(NoticeReader& reader)
+{
+    auto notice = Create();
+
+    notice->_resyncChanges = reader.ReadPaths().GetPaths();
+    notice->_infoChanges = reader.ReadPaths().GetPaths();
+    const SdfPathVector paths = reader.ReadPaths().GetPaths();
+    const auto offsets = reader.ReadUInt32Array();
+    const auto tokens = reader.ReadUInt32Array();
+
+    // Restore lexicographical order of paths.
+    std::sort(notice->_resyncChanges.begin(), notice->_resyncChanges.end());
+    std::sort(notice->_infoChanges.begin(), notice->_infoChanges.end());
+
+    if (offsets.size() == paths.size() + 1) {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            auto& fields = notice->_changedFields[paths[i]];
+            for (uint32_t j = offsets[i];
+                 j < offsets[i + 1] && j < tokens.size();
+                 ++j) {
+                fields.insert(reader.GetToken(tokens[j]));
+            }
+        }
+    }
+
+    // Categories are derived from changed fields if they were not written.
+    if (reader.AtEnd()) {
+        notice->_Categorize();
+        return notice;
+    }
+
+    const SdfPathVector categoryPaths = reader.ReadPaths().GetPaths();
+    const auto categories = reader.ReadUInt32Array();
+
+    if (categories.size() != categoryPaths.size()) {
+        notice->_Categorize();
+        return notice;
+    }
+
+    for (size_t i = 0; i < categoryPaths.size(); ++i) {
+        notice->_changeCategories[categoryPaths[i]] =
+            static_cast<ChangeCategory>(categories[i]);
+    }
+    notice->_UpdateCategories();
+
+    return notice;
+}
+
+namespace {
+
+// Collect layer with 'identifier' and its sublayers recursively into
+// 'layers'. Return false if one of the layers is not opened.
+bool _CollectLayers(const std::string& identifier, SdfLayerHandleSet& layers)
+{
+    const SdfLayerHandle layer = SdfLayer::Find(identifier);
+    if (!layer) return false;
+    if (!layers.insert(layer).second) return true;
+
+    bool result = true;
+    for (const auto& path : layer->GetSubLayerPaths()) {
+        result &= _CollectLayers(
+            SdfComputeAssetPathRelativeToLayer(layer, path), layers);
+    }
+    return result;
+}
+
+// Indicate whether 'layerStack' includes one of the layers with
+// 'identifiers', whether they are muted or not.
+bool _Includes(
+    const PcpLayerStack& layerStack,
+    const std::unordered_set<std::string>& identifiers)
+{
+    for (const auto& layer : layerStack.GetLayers()) {
+        if (identifiers.count(layer->GetIdentifier())) return true;
+    }
+
+    for (const auto& identifier : layerStack.GetMutedLayers()) {
+        if (identifiers.count(identifier)) return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
 LayerMutingChanged::LayerMutingChanged(
     const UsdNotice::LayerMutingChanged& notice)
+    : _stage(notice.GetStage())
 {
     for (const auto& layer : notice.GetMutedLayers()) {
         _mutedLayers.push_back(layer);
@@ -179,7 +1127,9 @@ LayerMutingChanged::LayerMutingChanged(
 }
 
 LayerMutingChanged::LayerMutingChanged(const LayerMutingChanged& other)
-    : _mutedLayers(other._mutedLayers), _unmutedLayers(other._unmutedLayers)
+    : _mutedLayers(other._mutedLayers),
+      _unmutedLayers(other._unmutedLayers),
+      _stage(other._stage)
 {
 }
 
@@ -189,6 +1139,8 @@ LayerMutingChanged& LayerMutingChanged::operator=(
     LayerMutingChanged copy(other);
     std::swap(_mutedLayers, copy._mutedLayers);
     std::swap(_unmutedLayers, copy._unmutedLayers);
+    _stage = copy._stage;
+    _cache = std::make_unique<_Cache>();
     return *this;
 }
 
@@ -222,6 +1174,289 @@ void LayerMutingChanged::Merge(LayerMutingChanged&& notice)
             _unmutedLayers.push_back(std::move(layer));
         }
     }
+
+    if (!_stage) _stage = notice._stage;
+
+    // Derived data must be computed again.
+    _cache = std::make_unique<_Cache>();
+}
+
+const SdfPathVector& LayerMutingChanged::GetAffectedPrimPaths() const
+{
+    std::call_once(_cache->affectedPrimPathsFlag, [this]() {
+        if (!_stage) return;
+
+        std::unordered_set<std::string> identifiers(
+            _mutedLayers.begin(), _mutedLayers.end());
+        identifiers.insert(_unmutedLayers.begin(), _unmutedLayers.end());
+        if (identifiers.empty()) return;
+
+        TfAutoMallocTag tag("unf", "LayerMutingChanged::GetAffectedPrimPaths");
+
+        // Muted layers are not part of the layer stacks anymore, so layers
+        // and their sublayers are retrieved from the registry. If one of
+        // them is not opened, every prim index including a layer stack
+        // affected is reported.
+        SdfLayerHandleSet layers;
+        bool complete = true;
+        for (const auto& identifier : identifiers) {
+            complete &= _CollectLayers(identifier, layers);
+        }
+
+        std::vector<UsdPrim> prims;
+        for (const auto& prim : _stage->TraverseAll()) {
+            prims.push_back(prim);
+        }
+
+        // Record whether each layer stack includes one of the layers, as
+        // layer stacks are shared by many prim indexes.
+        tbb::concurrent_unordered_map<const PcpLayerStack*, bool> layerStacks;
+
+        auto _IsAffected = [&](const PcpNodeRef& node) {
+            const PcpLayerStack* key = get_pointer(node.GetLayerStack());
+
+            auto it = layerStacks.find(key);
+            if (it == layerStacks.end()) {
+                it = layerStacks
+                         .insert({key, _Includes(*key, identifiers)})
+                         .first;
+            }
+
+            if (!it->second) return false;
+            if (!complete) return true;
+
+            const SdfPath& path = node.GetPath();
+            return std::any_of(
+                layers.begin(), layers.end(), [&](const SdfLayerHandle& l) {
+                    return l->HasSpec(path);
+                });
+        };
+
+        tbb::enumerable_thread_specific<SdfPathVector> threadPaths;
+
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, prims.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                auto& paths = threadPaths.local();
+
+                for (size_t i = range.begin(); i < range.end(); ++i) {
+                    const PcpPrimIndex& index = prims[i].GetPrimIndex();
+
+                    for (const PcpNodeRef& node : index.GetNodeRange()) {
+                        if (_IsAffected(node)) {
+                            paths.push_back(prims[i].GetPath());
+                            break;
+                        }
+                    }
+                }
+            });
+
+        auto& primPaths = _cache->affectedPrimPaths;
+        for (const auto& paths : threadPaths) {
+            primPaths.insert(primPaths.end(), paths.begin(), paths.end());
+        }
+
+        std::sort(primPaths.begin(), primPaths.end());
+    });
+
+    return _cache->affectedPrimPaths;
+}
+
+bool LayerMutingChanged::Serialize(NoticeWriter& writer) const
+{
+    writer.WriteStrings(_mutedLayers);
+    writer.WriteStrings(_unmutedLayers);
+    return true;
+}
+
+TfRefPtr<LayerMutingChanged> LayerMutingChanged::Deserialize(
+    NoticeReader& reader)
+{
+    auto notice = Create();
+    notice->_mutedLayers = reader.ReadStrings();
+    notice->_unmutedLayers = reader.ReadStrings();
+    return notice;
+}
+
+LayersChanged::LayersChanged(
+    const SdfNotice::LayersDidChange& notice, const SdfLayerHandleSet& layers)
+{
+    for (const auto& element : notice.GetChangeListVec()) {
+        if (layers.find(element.first) == layers.end()) continue;
+
+        auto& fieldMap = _changes[element.first->GetIdentifier()];
+
+        for (const auto& entry : element.second.GetEntryList()) {
+            auto& tokens = fieldMap[entry.first];
+
+            for (const auto& info : entry.second.infoChanged) {
+                tokens.insert(info.first);
+            }
+        }
+    }
+}
+
+LayersChanged::LayersChanged(const LayersChanged& other)
+    : _changes(other._changes)
+{
+}
+
+LayersChanged& LayersChanged::operator=(const LayersChanged& other)
+{
+    LayersChanged copy(other);
+    std::swap(_changes, copy._changes);
+    return *this;
+}
+
+void LayersChanged::Merge(LayersChanged&& notice)
+{
+    for (auto& element : notice._changes) {
+        auto it = _changes.find(element.first);
+        if (it == _changes.end()) {
+            _changes.emplace(element.first, std::move(element.second));
+            continue;
+        }
+
+        auto& fieldMap = it->second;
+        for (auto& entry : element.second) {
+            auto& tokens = fieldMap[entry.first];
+            if (tokens.empty()) {
+                tokens = std::move(entry.second);
+            }
+            else {
+                tokens.insert(entry.second.begin(), entry.second.end());
+            }
+        }
+    }
+}
+
+std::vector<std::string> LayersChanged::GetLayers() const
+{
+    std::vector<std::string> identifiers;
+    identifiers.reserve(_changes.size());
+
+    for (const auto& element : _changes) {
+        identifiers.push_back(element.first);
+    }
+
+    std::sort(identifiers.begin(), identifiers.end());
+    return identifiers;
+}
+
+SdfPathVector LayersChanged::GetChangedPaths(
+    const std::string& identifier) const
+{
+    SdfPathVector paths;
+
+    const auto it = _changes.find(identifier);
+    if (it == _changes.end()) return paths;
+
+    paths.reserve(it->second.size());
+    for (const auto& entry : it->second) {
+        paths.push_back(entry.first);
+    }
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+bool LayersChanged::Serialize(NoticeWriter& writer) const
+{
+    const auto identifiers = GetLayers();
+    writer.WriteUInt32(static_cast<uint32_t>(identifiers.size()));
+
+    for (const auto& identifier : identifiers) {
+        const auto& fieldMap = _changes.at(identifier);
+
+        // Changed fields are written following the order of the path table.
+        SdfPathVector paths;
+        paths.reserve(fieldMap.size());
+        for (const auto& entry : fieldMap) {
+            paths.push_back(entry.first);
+        }
+        NoticeWriter::SortPaths(&paths);
+
+        writer.WriteString(identifier);
+        writer.WritePaths(paths);
+
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> tokens;
+        offsets.reserve(paths.size() + 1);
+
+        for (const auto& path : paths) {
+            offsets.push_back(static_cast<uint32_t>(tokens.size()));
+            for (const auto& token : fieldMap.at(path)) {
+                tokens.push_back(writer.GetTokenIndex(token));
+            }
+        }
+        offsets.push_back(static_cast<uint32_t>(tokens.size()));
+
+        writer.WriteUInt32Array(offsets);
+        writer.WriteUInt32Array(tokens);
+    }
+
+    return true;
+}
+
+TfRefPtr<LayersChanged> LayersChanged::Deserialize(NoticeReader& reader)
+{
+    auto notice = Create();
+
+    const uint32_t count = reader.ReadUInt32();
+    for (uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+        const std::string identifier = reader.ReadString();
+        const SdfPathVector paths = reader.ReadPaths().GetPaths();
+        const auto offsets = reader.ReadUInt32Array();
+        const auto tokens = reader.ReadUInt32Array();
+
+        if (offsets.size() != paths.size() + 1) continue;
+
+        auto& fieldMap = notice->_changes[identifier];
+        for (size_t j = 0; j < paths.size(); ++j) {
+            auto& fields = fieldMap[paths[j]];
+            for (uint32_t k = offsets[j];
+                 k < offsets[j + 1] && k < tokens.size();
+                 ++k) {
+                fields.insert(reader.GetToken(tokens[k]));
+            }
+        }
+    }
+
+    return notice;
+}
+
+TfTokenSet LayersChanged::GetChangedFields(
+    const std::string& identifier, const SdfPath& path) const
+{
+    const auto it = _changes.find(identifier);
+    if (it == _changes.end()) return TfTokenSet();
+
+    const auto entry = it->second.find(path);
+    if (entry == it->second.end()) return TfTokenSet();
+
+    return entry->second;
+}
+
+bool LayersChanged::HasChangedFields(
+    const std::string& identifier, const SdfPath& path) const
+{
+    const auto it = _changes.find(identifier);
+    if (it == _changes.end()) return false;
+
+    const auto entry = it->second.find(path);
+    return entry != it->second.end() && !entry->second.empty();
+}
+
+size_t TransactionCommitted::GetMemoryUsage() const
+{
+    size_t size = sizeof(*this);
+    size += _notices.capacity() * sizeof(StageNoticeRefPtr);
+
+    for (const auto& notice : _notices) {
+        size += notice->GetMemoryUsage();
+    }
+
+    return size;
 }
 
 }  // namespace UnfNotice
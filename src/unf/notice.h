@@ -6,20 +6,32 @@
 #include "unf/api.h"
 
 #include <pxr/base/arch/demangle.h>
+#include <pxr/base/tf/mallocTag.h>
 #include <pxr/base/tf/notice.h>
 #include <pxr/base/tf/refBase.h>
 #include <pxr/base/tf/refPtr.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/notice.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace unf {
 
+class NoticeReader;
+class NoticeWriter;
+
 /// Convenient alias for set of tokens.
 using TfTokenSet =
     std::unordered_set<PXR_NS::TfToken, PXR_NS::TfToken::HashFunctor>;
@@ -31,6 +43,168 @@ using SdfPathSet = std::unordered_set<PXR_NS::SdfPath, PXR_NS::SdfPath::Hash>;
 using ChangedFieldMap =
     std::unordered_map<PXR_NS::SdfPath, TfTokenSet, PXR_NS::SdfPath::Hash>;
 
+/// Convenient alias for map of paths organized per path.
+using SdfPathVectorMap = std::unordered_map<
+    PXR_NS::SdfPath, PXR_NS::SdfPathVector, PXR_NS::SdfPath::Hash>;
+
+/// Convenient alias for map of changed field maps organized per layer
+/// identifier.
+using LayerChangedFieldMap = std::unordered_map<std::string, ChangedFieldMap>;
+
+/// \brief
+/// Policy defining how UnfNotice::ObjectsChanged notices are coarsened to
+/// bound the number of paths that listeners need to process.
+///
+/// \sa UnfNotice::ObjectsChanged::Coarsen
+struct CoarseningPolicy {
+    /// \brief
+    /// Maximum number of changed children per prim.
+    ///
+    /// Changes on more children are replaced by a resync of the prim. Zero
+    /// means that the number of children is not limited.
+    size_t maxChildren = 0;
+
+    /// \brief
+    /// Maximum number of paths held by the notice.
+    ///
+    /// Deepest changes are replaced by a resync of their parent prim until
+    /// the notice fits within the budget. Zero means that the number of
+    /// paths is not limited.
+    size_t maxPaths = 0;
+
+    /// \brief
+    /// Indicate whether changes can be collapsed into a resync of the
+    /// pseudo-root.
+    ///
+    /// If enabled, a notice still exceeding \a maxPaths once all changes
+    /// have been collapsed into root prims is replaced by a resync of the
+    /// pseudo-root.
+    bool collapseToRoot = false;
+
+    /// Indicate whether the policy can coarsen notices.
+    bool IsEnabled() const { return maxChildren > 0 || maxPaths > 0; }
+};
+
+/// \brief
+/// Categories of changes recorded per path by UnfNotice::ObjectsChanged.
+///
+/// Categories are bit flags, so that a path modified in several ways holds
+/// several categories.
+enum class ChangeCategory : uint32_t {
+    /// No change recorded.
+    None = 0,
+    /// \brief
+    /// Path resynced by a structural change (e.g. spec added or removed,
+    /// or composition arc modified).
+    Structure = 1 << 0,
+    /// Path resynced because asset paths are resolved differently.
+    ResolvedAssetPath = 1 << 1,
+    /// "default" field modified without resync.
+    Value = 1 << 2,
+    /// "timeSamples" field modified without resync.
+    TimeSamples = 1 << 3,
+    /// Other fields modified without resync.
+    Metadata = 1 << 4,
+};
+
+/// Combine categories \p lhs and \p rhs.
+inline ChangeCategory operator|(ChangeCategory lhs, ChangeCategory rhs)
+{
+    return static_cast<ChangeCategory>(
+        static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+/// Return categories held by both \p lhs and \p rhs.
+inline ChangeCategory operator&(ChangeCategory lhs, ChangeCategory rhs)
+{
+    return static_cast<ChangeCategory>(
+        static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+/// Return all categories which are not in \p value.
+inline ChangeCategory operator~(ChangeCategory value)
+{
+    return static_cast<ChangeCategory>(~static_cast<uint32_t>(value));
+}
+
+/// Add categories \p rhs to \p lhs.
+inline ChangeCategory& operator|=(ChangeCategory& lhs, ChangeCategory rhs)
+{
+    return lhs = lhs | rhs;
+}
+
+/// Convenient alias for map of change categories organized per path.
+using ChangeCategoryMap = std::
+    unordered_map<PXR_NS::SdfPath, ChangeCategory, PXR_NS::SdfPath::Hash>;
+
+/// \class MergePolicy
+///
+/// \brief
+/// Policy defining how notices of the same type are consolidated during a
+/// transaction.
+///
+/// \sa UnfNotice::StageNotice::GetMergePolicy
+class MergePolicy {
+  public:
+    /// Consolidation mode.
+    enum class Mode {
+        /// Merge all notices into the first one.
+        Merge,
+        /// Keep all notices.
+        KeepAll,
+        /// Keep the latest notice only.
+        KeepLatest,
+        /// Keep the first and the latest notices only.
+        KeepFirstAndLast,
+        /// Keep a bounded number of the latest notices.
+        BoundedRing,
+    };
+
+    /// Create a policy which merges all notices into the first one.
+    static MergePolicy Merge() { return MergePolicy(Mode::Merge, 0); }
+
+    /// Create a policy which keeps all notices.
+    static MergePolicy KeepAll() { return MergePolicy(Mode::KeepAll, 0); }
+
+    /// Create a policy which keeps the latest notice only.
+    static MergePolicy KeepLatest()
+    {
+        return MergePolicy(Mode::KeepLatest, 1);
+    }
+
+    /// Create a policy which keeps the first and the latest notices only.
+    static MergePolicy KeepFirstAndLast()
+    {
+        return MergePolicy(Mode::KeepFirstAndLast, 2);
+    }
+
+    /// \brief
+    /// Create a policy which keeps the \p capacity latest notices.
+    ///
+    /// A capacity of zero is treated as one.
+    static MergePolicy BoundedRing(size_t capacity)
+    {
+        return MergePolicy(Mode::BoundedRing, capacity > 0 ? capacity : 1);
+    }
+
+    /// Return consolidation mode.
+    Mode GetMode() const { return _mode; }
+
+    /// \brief
+    /// Return maximum number of notices kept per transaction.
+    ///
+    /// Return zero if the number of notices is not bounded.
+    size_t GetCapacity() const { return _capacity; }
+
+  private:
+    MergePolicy(Mode mode, size_t capacity) : _mode(mode), _capacity(capacity)
+    {
+    }
+
+    Mode _mode;
+    size_t _capacity;
+};
+
 namespace UnfNotice {
 
 /// \class StageNotice
@@ -58,6 +232,21 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
     /// \sa NoticeTransaction
     UNF_API virtual bool IsMergeable() const { return true; }
 
+    /// \brief
+    /// Return policy defining how notices from the same type are
+    /// consolidated during a transaction.
+    ///
+    /// By default, MergePolicy::Merge is returned if the notice is
+    /// mergeable, and MergePolicy::KeepAll otherwise. Other policies are
+    /// enforced while notices are captured, so that the number of notices
+    /// kept is bounded.
+    ///
+    /// \sa IsMergeable
+    UNF_API virtual MergePolicy GetMergePolicy() const
+    {
+        return IsMergeable() ? MergePolicy::Merge() : MergePolicy::KeepAll();
+    }
+
     /// \brief
     /// Interface method for merging StageNotice.
     ///
@@ -76,6 +265,23 @@ class StageNotice : public PXR_NS::TfNotice, public PXR_NS::TfRefBase {
     /// By default, no process is done.
     virtual void PostProcess() {}
 
+    /// \brief
+    /// Base method for writing the content of the notice with \p writer.
+    ///
+    /// Return false if the notice cannot be serialized, which is the default.
+    /// Notices which override this method should also be registered via
+    /// NoticeSerializationDefine to be re-created from serialized data.
+    ///
+    /// \sa NoticeSerializer
+    UNF_API virtual bool Serialize(NoticeWriter&) const { return false; }
+
+    /// \brief
+    /// Return an estimate of the memory held by the notice in bytes.
+    ///
+    /// By default, only the size of the object is returned. Notices holding
+    /// containers should override this method to include their content.
+    UNF_API virtual size_t GetMemoryUsage() const { return sizeof(*this); }
+
     /// \brief
     /// Interface method for returing unique type identifier.
     ///
@@ -171,6 +377,13 @@ class StageNoticeImpl : public StageNotice {
     /// By default, no data is moved.
     virtual void Merge(Self&&) {}
 
+    /// \brief
+    /// Base method for returning an estimate of the memory held by the
+    /// notice in bytes.
+    ///
+    /// By default, the size of the derived object is returned.
+    virtual size_t GetMemoryUsage() const override { return sizeof(Self); }
+
     /// \brief
     /// Base method for returing unique type identifier.
     ///
@@ -189,6 +402,7 @@ class StageNoticeImpl : public StageNotice {
     /// with PXR_NS::TfRefPtr.
     virtual StageNotice* _Clone() const override
     {
+        PXR_NS::TfAutoMallocTag tag("unf", "StageNotice::Clone");
         return new Self(static_cast<const Self&>(*this));
     }
 };
@@ -205,7 +419,27 @@ class StageContentsChanged : public StageNoticeImpl<StageContentsChanged> {
   public:
     UNF_API virtual ~StageContentsChanged() = default;
 
+    /// \brief
+    /// Write the content of the notice with \p writer.
+    ///
+    /// \note
+    /// This notice does not hold any data.
+    UNF_API virtual bool Serialize(NoticeWriter&) const override
+    {
+        return true;
+    }
+
+    /// Create notice from data read with \p reader.
+    UNF_API static PXR_NS::TfRefPtr<StageContentsChanged> Deserialize(
+        NoticeReader&)
+    {
+        return Create();
+    }
+
   protected:
+    /// Create empty notice.
+    StageContentsChanged() = default;
+
     /// Create notice from PXR_NS::UsdNotice::StageContentsChanged instance.
     explicit StageContentsChanged(
         const PXR_NS::UsdNotice::StageContentsChanged&)
@@ -226,7 +460,7 @@ class StageContentsChanged : public StageNoticeImpl<StageContentsChanged> {
 /// PXR_NS::UsdNotice::ObjectsChanged notice type.
 class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
   public:
-    UNF_API virtual ~ObjectsChanged() = default;
+    UNF_API virtual ~ObjectsChanged();
 
     /// Copy constructor.
     UNF_API ObjectsChanged(const ObjectsChanged&);
@@ -244,6 +478,13 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     /// \note
     /// Data will be move out of incoming ObjectsChanged notice.
     UNF_API virtual void Merge(ObjectsChanged&&) override;
+
+    /// \brief
+    /// Remove resynced paths which are descendants of other resynced paths.
+    ///
+    /// \note
+    /// The operation is deferred until the resynced paths are accessed, so
+    /// that it costs nothing if the notice is never queried.
     UNF_API virtual void PostProcess() override;
 
     /// \brief
@@ -280,6 +521,7 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     /// Equivalent from PXR_NS::UsdNotice::ObjectsChanged::GetResyncedPaths
     UNF_API const PXR_NS::SdfPathVector& GetResyncedPaths() const
     {
+        _EnsurePostProcessed();
         return _resyncChanges;
     }
 
@@ -331,26 +573,294 @@ class ObjectsChanged : public StageNoticeImpl<ObjectsChanged> {
     /// const
     UNF_API bool HasChangedFields(const PXR_NS::SdfPath&) const;
 
+    /// \brief
+    /// Indicate for each path in \p paths whether it or one of its ancestors
+    /// was resynced.
+    ///
+    /// \p paths do not need to be sorted. All paths are answered with a
+    /// single merge-join pass over the sorted changes held by the notice,
+    /// which is processed in parallel for large inputs.
+    ///
+    /// \sa ResyncedObject
+    UNF_API std::vector<bool> QueryResynced(
+        const PXR_NS::SdfPathVector& paths) const;
+
+    /// \brief
+    /// Indicate for each path in \p paths whether it or one of its ancestors
+    /// was modified but not resynced.
+    ///
+    /// \sa ChangedInfoOnly, QueryResynced
+    UNF_API std::vector<bool> QueryChangedInfoOnly(
+        const PXR_NS::SdfPathVector& paths) const;
+
+    /// \brief
+    /// Indicate for each path in \p paths whether it or one of its ancestors
+    /// was resynced or modified.
+    ///
+    /// \sa AffectedObject, QueryResynced
+    UNF_API std::vector<bool> QueryAffected(
+        const PXR_NS::SdfPathVector& paths) const;
+
+    /// \brief
+    /// Indicate for each path in \p paths whether any changed fields
+    /// affected it.
+    ///
+    /// \sa HasChangedFields
+    UNF_API std::vector<bool> QueryHasChangedFields(
+        const PXR_NS::SdfPathVector& paths) const;
+
+    /// \brief
+    /// Return for each path in \p paths the categories of changes recorded
+    /// on the path or its ancestors.
+    ///
+    /// ChangeCategory::None is returned for paths which were not affected.
+    ///
+    /// \sa GetChangeCategories, QueryResynced
+    UNF_API std::vector<ChangeCategory> QueryChangeCategories(
+        const PXR_NS::SdfPathVector& paths) const;
+
     /// \brief
     /// Return map of affected token sets organized per path.
     const ChangedFieldMap& GetChangedFieldMap() const { return _changedFields; }
 
+    /// \brief
+    /// Return categories of all changes held by the notice.
+    ///
+    /// Categories are computed once when the notice is created and
+    /// preserved when notices are merged, so that listeners can cheaply
+    /// skip notices which cannot affect them:
+    ///
+    /// \code{.cpp}
+    /// using unf::ChangeCategory;
+    ///
+    /// // Ignore notices holding time sample edits only.
+    /// const auto categories = notice.GetChangeCategories();
+    /// if ((categories & ~ChangeCategory::TimeSamples) == ChangeCategory::None)
+    ///     return;
+    /// \endcode
+    ChangeCategory GetChangeCategories() const { return _categories; }
+
+    /// \brief
+    /// Return categories of changes recorded on \p path.
+    ///
+    /// Categories of resynced ancestors are not included. Return
+    /// ChangeCategory::None if no change was recorded on \p path.
+    UNF_API ChangeCategory GetChangeCategories(
+        const PXR_NS::SdfPath& path) const;
+
+    /// Return map of change categories organized per path.
+    const ChangeCategoryMap& GetChangeCategoryMap() const
+    {
+        return _changeCategories;
+    }
+
+    /// \brief
+    /// Return unique prim paths owning resynced paths in lexicographical
+    /// order.
+    ///
+    /// \note
+    /// Derived views are computed once when first requested and shared by
+    /// all listeners receiving the notice. They are safe to access
+    /// concurrently.
+    UNF_API const PXR_NS::SdfPathVector& GetResyncedPrimPaths() const;
+
+    /// \brief
+    /// Return resynced and modified property paths organized per owning
+    /// prim path.
+    ///
+    /// Property paths are sorted in lexicographical order.
+    UNF_API const SdfPathVectorMap& GetChangedPropertiesByPrim() const;
+
+    /// \brief
+    /// Return prim paths, in lexicographical order, for which only
+    /// attribute values were modified.
+    ///
+    /// A prim is listed if one of its properties changed info only with
+    /// "default" or "timeSamples" fields only.
+    ///
+    /// \note
+    /// A prim can be listed in both GetValueChangedPrimPaths and
+    /// GetMetadataChangedPrimPaths.
+    UNF_API const PXR_NS::SdfPathVector& GetValueChangedPrimPaths() const;
+
+    /// \brief
+    /// Return prim paths, in lexicographical order, for which metadata
+    /// were modified on the prim or one of its properties without resync.
+    UNF_API const PXR_NS::SdfPathVector& GetMetadataChangedPrimPaths() const;
+
+    /// \brief
+    /// Return unique prim paths owning resynced or modified paths in
+    /// lexicographical order.
+    UNF_API const PXR_NS::SdfPathVector& GetAffectedPrimPaths() const;
+
+    /// \brief
+    /// Split notice into chunks of at most \p size paths.
+    ///
+    /// Each chunk is a valid ObjectsChanged notice holding a contiguous range
+    /// of paths in lexicographical order, so that each chunk covers a
+    /// region of the namespace. Chunks holding resynced paths are returned
+    /// before chunks holding paths modified but not resynced.
+    ///
+    /// Changed fields are kept with the chunk holding the corresponding path,
+    /// or its closest resynced ancestor.
+    ///
+    /// A copy of the notice is returned if \p size is zero or if the notice
+    /// holds fewer paths.
+    UNF_API std::vector<PXR_NS::TfRefPtr<ObjectsChanged> > Split(
+        size_t size) const;
+
+    /// \brief
+    /// Replace changes by resyncs of their ancestors according to
+    /// \p policy.
+    ///
+    /// Changed fields of replaced paths are removed. Return true if the
+    /// notice was coarsened.
+    ///
+    /// \sa IsCoarsened
+    UNF_API bool Coarsen(const CoarseningPolicy& policy);
+
+    /// \brief
+    /// Indicate whether changes were replaced by resyncs of their ancestors.
+    ///
+    /// Listeners should process resynced paths of a coarsened notice as
+    /// whole subtrees, as individual changes are not available.
+    bool IsCoarsened() const { return _coarsened; }
+
+    /// \brief
+    /// Remove paths outside of \p subtrees and fields within
+    /// \p ignoredFields from the notice.
+    ///
+    /// Resynced paths are kept if they are within or above one of
+    /// \p subtrees, as resyncing an ancestor affects the whole subtree. Other
+    /// paths are kept if they are within one of \p subtrees. All paths are
+    /// kept if \p subtrees is empty.
+    ///
+    /// Paths modified but not resynced are removed if all their changed
+    /// fields are ignored.
+    ///
+    /// Return false if the notice does not hold any path after trimming.
+    UNF_API bool Trim(
+        const PXR_NS::SdfPathVector& subtrees,
+        const TfTokenSet& ignoredFields);
+
+    /// \brief
+    /// Write the content of the notice with \p writer.
+    ///
+    /// Resynced paths, changed info paths and paths with changed fields are
+    /// written as path tables, which can be queried in place with
+    /// ObjectsChangedView.
+    UNF_API virtual bool Serialize(NoticeWriter& writer) const override;
+
+    /// \brief
+    /// Return an estimate of the memory held by the notice in bytes.
+    ///
+    /// Include path lists, changed field map and derived views computed so
+    /// far.
+    UNF_API virtual size_t GetMemoryUsage() const override;
+
+    /// Create notice from data read with \p reader.
+    UNF_API static PXR_NS::TfRefPtr<ObjectsChanged> Deserialize(
+        NoticeReader& reader);
+
   protected:
+    /// Create empty notice.
+    ObjectsChanged() = default;
+
     /// Create notice from PXR_NS::UsdNotice::ObjectsChanged instance.
     explicit ObjectsChanged(const PXR_NS::UsdNotice::ObjectsChanged&);
 
+    /// \brief
+    /// Create notice from \p resyncedPaths, \p changedInfoOnlyPaths and
+    /// \p changedFields.
+    ObjectsChanged(
+        PXR_NS::SdfPathVector resyncedPaths,
+        PXR_NS::SdfPathVector changedInfoOnlyPaths,
+        ChangedFieldMap changedFields);
+
     /// Ensure that StageNoticeImpl::Create method can call constructor.
     friend StageNoticeImpl<ObjectsChanged>;
 
   private:
+    /// Apply deferred PostProcess if necessary.
+    void _EnsurePostProcessed() const;
+
+    /// \brief
+    /// Replace all paths within \p prims by a resync of these prims.
+    void _Collapse(const SdfPathSet& prims);
+
+    /// Compute value and metadata changed prim paths.
+    void _ComputePrimChanges() const;
+
+    /// Return resynced paths in lexicographical order.
+    const PXR_NS::SdfPathVector& _GetSortedResyncedPaths() const;
+
+    /// Return paths modified but not resynced in lexicographical order.
+    const PXR_NS::SdfPathVector& _GetSortedChangedInfoOnlyPaths() const;
+
+    /// Record categories of resynced and modified paths from changed fields.
+    void _Categorize();
+
+    /// Update categories of all changes from categories recorded per path.
+    void _UpdateCategories();
+
+    /// Lazily computed data, reset when notice is merged.
+    struct _Cache {
+        std::once_flag resyncedPrimPathsFlag;
+        PXR_NS::SdfPathVector resyncedPrimPaths;
+
+        std::once_flag propertiesFlag;
+        SdfPathVectorMap properties;
+
+        std::once_flag primChangesFlag;
+        PXR_NS::SdfPathVector valueChangedPrimPaths;
+        PXR_NS::SdfPathVector metadataChangedPrimPaths;
+
+        std::once_flag affectedPrimPathsFlag;
+        PXR_NS::SdfPathVector affectedPrimPaths;
+
+        // Only filled if paths held by the notice are not sorted.
+        std::once_flag sortedResyncPathsFlag;
+        PXR_NS::SdfPathVector sortedResyncPaths;
+
+        std::once_flag sortedInfoPathsFlag;
+        PXR_NS::SdfPathVector sortedInfoPaths;
+    };
+
+    /// Return derived data, which is allocated on first query.
+    _Cache& _GetCache() const;
+
+    /// Release derived data so that it is computed again on next query.
+    void _ResetCache();
+
     /// List of resynced paths.
-    PXR_NS::SdfPathVector _resyncChanges;
+    ///
+    /// Mutable so that deferred PostProcess can be applied on access.
+    mutable PXR_NS::SdfPathVector _resyncChanges;
 
     /// List of paths which are modified but not resynced.
     PXR_NS::SdfPathVector _infoChanges;
 
     /// Map of affected token sets organized per path.
     ChangedFieldMap _changedFields;
+
+    /// Map of change categories organized per path.
+    ChangeCategoryMap _changeCategories;
+
+    /// Categories of all changes.
+    ChangeCategory _categories = ChangeCategory::None;
+
+    /// Indicate whether PostProcess was requested and not applied yet.
+    mutable std::atomic<bool> _postProcess{false};
+
+    /// Protect deferred PostProcess when the notice is queried from
+    /// several threads.
+    mutable std::mutex _postProcessMutex;
+
+    /// Indicate whether changes were replaced by resyncs of ancestors.
+    bool _coarsened = false;
+
+    /// Derived data computed on demand, or null if not queried yet.
+    mutable std::atomic<_Cache*> _cache{nullptr};
 };
 
 /// \class StageEditTargetChanged
@@ -364,7 +874,27 @@ class StageEditTargetChanged : public StageNoticeImpl<StageEditTargetChanged> {
   public:
     UNF_API virtual ~StageEditTargetChanged() = default;
 
+    /// \brief
+    /// Write the content of the notice with \p writer.
+    ///
+    /// \note
+    /// This notice does not hold any data.
+    UNF_API virtual bool Serialize(NoticeWriter&) const override
+    {
+        return true;
+    }
+
+    /// Create notice from data read with \p reader.
+    UNF_API static PXR_NS::TfRefPtr<StageEditTargetChanged> Deserialize(
+        NoticeReader&)
+    {
+        return Create();
+    }
+
   protected:
+    /// Create empty notice.
+    StageEditTargetChanged() = default;
+
     /// Create notice from PXR_NS::UsdNotice::StageEditTargetChanged instance.
     explicit StageEditTargetChanged(
         const PXR_NS::UsdNotice::StageEditTargetChanged&)
@@ -425,7 +955,38 @@ class LayerMutingChanged : public StageNoticeImpl<LayerMutingChanged> {
         return _unmutedLayers;
     }
 
+    /// \brief
+    /// Return paths of prims whose composition includes one of the muted or
+    /// unmuted layers, in lexicographical order.
+    ///
+    /// A prim is affected when one of its prim index nodes uses a layer
+    /// stack which includes one of the layers, and one of the layers or
+    /// their sublayers holds a spec for the node. If one of the layers is
+    /// not opened anymore, all prims using the layer stack are reported.
+    ///
+    /// Prim indexes of the stage which emitted the notice are inspected in
+    /// parallel the first time this method is called, and the result is
+    /// cached until the notice is merged. Muted layers are still recorded by
+    /// the layer stacks, so the result can be computed before or after the
+    /// stage is recomposed. However, prims removed from the stage by the
+    /// recomposition cannot be reported anymore. Descendants of instances
+    /// are not inspected.
+    ///
+    /// Return an empty vector if the stage has expired, e.g. for notices
+    /// created with Deserialize.
+    UNF_API const PXR_NS::SdfPathVector& GetAffectedPrimPaths() const;
+
+    /// Write the content of the notice with \p writer.
+    UNF_API virtual bool Serialize(NoticeWriter& writer) const override;
+
+    /// Create notice from data read with \p reader.
+    UNF_API static PXR_NS::TfRefPtr<LayerMutingChanged> Deserialize(
+        NoticeReader& reader);
+
   protected:
+    /// Create empty notice.
+    LayerMutingChanged() = default;
+
     /// Create notice from PXR_NS::UsdNotice::LayerMutingChanged instance.
     explicit LayerMutingChanged(const PXR_NS::UsdNotice::LayerMutingChanged&);
 
@@ -433,11 +994,157 @@ class LayerMutingChanged : public StageNoticeImpl<LayerMutingChanged> {
     friend StageNoticeImpl<LayerMutingChanged>;
 
   private:
+    /// Lazily computed data, reset when notice is merged.
+    struct _Cache {
+        std::once_flag affectedPrimPathsFlag;
+        PXR_NS::SdfPathVector affectedPrimPaths;
+    };
+
     /// List of layer identifiers that were muted.
     std::vector<std::string> _mutedLayers;
 
     /// List of layer identifiers that were unmuted.
     std::vector<std::string> _unmutedLayers;
+
+    /// Stage which emitted the notice.
+    PXR_NS::UsdStageWeakPtr _stage;
+
+    /// Derived data computed on demand.
+    std::unique_ptr<_Cache> _cache = std::make_unique<_Cache>();
+};
+
+/// \class LayersChanged
+///
+/// \brief
+/// Notice sent after specs have been modified in layers used by the stage.
+///
+/// This notice type is the standalone equivalent of the
+/// PXR_NS::SdfNotice::LayersDidChange notice type, restricted to the layers
+/// used by the stage. Changes are recorded per layer identifier, without
+/// composing them on the stage.
+///
+/// \note
+/// This notice is emitted by the LayerDispatcher, which is not added to the
+/// Broker by default.
+class LayersChanged : public StageNoticeImpl<LayersChanged> {
+  public:
+    UNF_API virtual ~LayersChanged() = default;
+
+    /// Copy constructor.
+    UNF_API LayersChanged(const LayersChanged&);
+
+    /// Assignment operator.
+    UNF_API LayersChanged& operator=(const LayersChanged&);
+
+    // Bring all Merge declarations from base class to prevent
+    // overloaded-virtual warning.
+    using StageNoticeImpl<LayersChanged>::Merge;
+
+    /// \brief
+    /// Merge notice with another LayersChanged notice.
+    ///
+    /// \note
+    /// Data will be move out of incoming LayersChanged notice.
+    UNF_API virtual void Merge(LayersChanged&&) override;
+
+    /// Return identifiers of the layers that were changed.
+    UNF_API std::vector<std::string> GetLayers() const;
+
+    /// \brief
+    /// Return vector of spec paths that were changed in the layer identified
+    /// by \p identifier, in lexicographical order.
+    UNF_API PXR_NS::SdfPathVector GetChangedPaths(
+        const std::string& identifier) const;
+
+    /// \brief
+    /// Return the set of changed fields for the spec at \p path in the layer
+    /// identified by \p identifier.
+    UNF_API TfTokenSet GetChangedFields(
+        const std::string& identifier, const PXR_NS::SdfPath& path) const;
+
+    /// \brief
+    /// Indicate whether any fields changed for the spec at \p path in the
+    /// layer identified by \p identifier.
+    UNF_API bool HasChangedFields(
+        const std::string& identifier, const PXR_NS::SdfPath& path) const;
+
+    /// \brief
+    /// Return map of changed token sets organized per spec path and per layer
+    /// identifier.
+    ///
+    /// \note
+    /// Spec paths changed without any field modification (e.g. when a spec is
+    /// added or removed) are recorded with an empty token set.
+    const LayerChangedFieldMap& GetChangedFieldMap() const { return _changes; }
+
+    /// Write the content of the notice with \p writer.
+    UNF_API virtual bool Serialize(NoticeWriter& writer) const override;
+
+    /// Create notice from data read with \p reader.
+    UNF_API static PXR_NS::TfRefPtr<LayersChanged> Deserialize(
+        NoticeReader& reader);
+
+  protected:
+    /// Create empty notice.
+    LayersChanged() = default;
+
+    /// \brief
+    /// Create notice from PXR_NS::SdfNotice::LayersDidChange instance.
+    ///
+    /// Only changes from \p layers are recorded.
+    LayersChanged(
+        const PXR_NS::SdfNotice::LayersDidChange&,
+        const PXR_NS::SdfLayerHandleSet& layers);
+
+    /// Ensure that StageNoticeImpl::Create method can call constructor.
+    friend StageNoticeImpl<LayersChanged>;
+
+  private:
+    /// Map of changed token sets organized per spec path and per layer.
+    LayerChangedFieldMap _changes;
+};
+
+/// \class TransactionCommitted
+///
+/// \brief
+/// Notice sent when the outermost transaction ends, holding all notices
+/// consolidated during the transaction.
+///
+/// Notices are ordered by the first time a notice of their type was
+/// captured, so that listeners can process all changes from a transaction
+/// with a single callback.
+///
+/// \note
+/// This notice is only sent if enabled with Broker::SetCommitDelivery.
+class TransactionCommitted : public StageNoticeImpl<TransactionCommitted> {
+  public:
+    UNF_API virtual ~TransactionCommitted() = default;
+
+    /// Notices are never consolidated.
+    UNF_API virtual bool IsMergeable() const override { return false; }
+
+    /// Return an estimate of the memory held by the notice in bytes.
+    UNF_API virtual size_t GetMemoryUsage() const override;
+
+    /// Return notices consolidated during the transaction.
+    const std::vector<StageNoticeRefPtr>& GetNotices() const
+    {
+        return _notices;
+    }
+
+  protected:
+    /// Create notice from \p notices.
+    TransactionCommitted(std::vector<StageNoticeRefPtr> notices)
+        : _notices(std::move(notices))
+    {
+    }
+
+    /// Ensure that StageNoticeImpl::Create method can call constructor.
+    friend StageNoticeImpl<TransactionCommitted>;
+
+  private:
+    /// Notices consolidated during the transaction.
+    std::vector<StageNoticeRefPtr> _notices;
 };
 
 }  // namespace UnfNotice
@@ -0,0 +1,238 @@
+#include "unf/recorder.h"
+#include "unf/broker.h"
+#include "unf/capturePredicate.h"
+#include "unf/notice.h"
+#include "unf/serialization.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/pxr.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+namespace {
+
+// Magic number and version written at the start of each recording.
+const char _Magic[4] = {'U', 'N', 'F', 'R'};
+const uint32_t _Version = 1;
+
+// Size of the header written before each event (type and data size).
+const size_t _EventHeaderSize = 8;
+
+}  // namespace
+
+NoticeRecorder::NoticeRecorder(
+    const BrokerWeakPtr& broker, const std::string& filePath)
+    : _broker(broker)
+{
+    if (!_broker) {
+        TF_CODING_ERROR("Invalid broker.");
+        return;
+    }
+
+    if (_broker->_recorder) {
+        TF_CODING_ERROR("A recorder is already attached to this broker.");
+        return;
+    }
+
+    _stream.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!_stream) {
+        TF_RUNTIME_ERROR("Failed to open '%s' for writing.", filePath.c_str());
+        return;
+    }
+
+    NoticeWriter writer;
+    writer.WriteUInt32(_Version);
+
+    _stream.write(_Magic, sizeof(_Magic));
+    _stream.write(writer.GetData().data(), writer.GetData().size());
+
+    _broker->_recorder = this;
+    _recording = true;
+}
+
+NoticeRecorder::~NoticeRecorder() { Stop(); }
+
+void NoticeRecorder::Stop()
+{
+    if (!_recording) return;
+
+    // Broker might have expired before the recorder.
+    if (_broker) _broker->_recorder = nullptr;
+    _recording = false;
+    _stream.close();
+}
+
+void NoticeRecorder::_RecordSend(const UnfNotice::StageNoticeRefPtr& notice)
+{
+    _Write(EventType::Send, NoticeSerializer::Serialize({notice}));
+}
+
+void NoticeRecorder::_RecordBeginTransaction()
+{
+    _Write(EventType::BeginTransaction);
+}
+
+void NoticeRecorder::_RecordEndTransaction()
+{
+    _Write(EventType::EndTransaction);
+}
+
+void NoticeRecorder::_RecordCapture(bool captured)
+{
+    NoticeWriter writer;
+    writer.WriteUInt32(captured ? 1 : 0);
+
+    _Write(EventType::Capture, writer.GetData());
+}
+
+void NoticeRecorder::_Write(EventType type, const std::vector<char>& data)
+{
+    NoticeWriter writer;
+    writer.WriteUInt32(static_cast<uint32_t>(type));
+    writer.WriteUInt32(static_cast<uint32_t>(data.size()));
+
+    _stream.write(writer.GetData().data(), writer.GetData().size());
+    _stream.write(data.data(), data.size());
+    _eventCount++;
+}
+
+NoticeRecording::NoticeRecording(const std::string& filePath)
+{
+    std::ifstream stream(filePath, std::ios::in | std::ios::binary);
+    if (!stream) {
+        TF_RUNTIME_ERROR("Failed to open '%s' for reading.", filePath.c_str());
+        return;
+    }
+
+    _data.assign(
+        std::istreambuf_iterator<char>(stream),
+        std::istreambuf_iterator<char>());
+
+    if (_data.size() < sizeof(_Magic) + 4
+        || std::memcmp(_data.data(), _Magic, sizeof(_Magic)) != 0) {
+        TF_RUNTIME_ERROR("Invalid notice recording: '%s'", filePath.c_str());
+        return;
+    }
+
+    const uint32_t version =
+        NoticeReader::DecodeUInt32(_data.data() + sizeof(_Magic));
+    if (version != _Version) {
+        TF_RUNTIME_ERROR(
+            "Unsupported notice recording version: %u", version);
+        return;
+    }
+
+    size_t offset = sizeof(_Magic) + 4;
+    while (offset + _EventHeaderSize <= _data.size()) {
+        const char* header = _data.data() + offset;
+        const auto type = static_cast<NoticeRecorder::EventType>(
+            NoticeReader::DecodeUInt32(header, 0));
+        const size_t size = NoticeReader::DecodeUInt32(header, 1);
+
+        offset += _EventHeaderSize;
+        if (offset + size > _data.size()) break;
+
+        _events.push_back({type, offset, size});
+        offset += size;
+    }
+
+    if (offset != _data.size()) {
+        TF_RUNTIME_ERROR("Truncated notice recording: '%s'", filePath.c_str());
+        return;
+    }
+
+    _valid = true;
+}
+
+size_t NoticeRecording::GetNoticeCount() const
+{
+    size_t count = 0;
+    for (const auto& event : _events) {
+        if (event.type == NoticeRecorder::EventType::Send) count++;
+    }
+    return count;
+}
+
+size_t NoticeRecording::Replay(const BrokerPtr& broker) const
+{
+    if (!_valid) return 0;
+
+    // Re-create all notices first, as notices are modified when merged
+    // within a transaction.
+    std::vector<UnfNotice::StageNoticeRefPtr> notices;
+    notices.reserve(_events.size());
+
+    for (const auto& event : _events) {
+        if (event.type != NoticeRecorder::EventType::Send) continue;
+
+        SerializedNotices serialized(_data.data() + event.offset, event.size);
+        notices.push_back(
+            serialized.size() > 0 ? serialized.Deserialize(0) : nullptr);
+    }
+
+    // Only the predicate of the innermost transaction is used to capture a
+    // notice, so a single decision can be shared between all transactions.
+    bool decision = true;
+    auto predicate = [&](const UnfNotice::StageNotice&) { return decision; };
+
+    size_t sent = 0;
+    size_t index = 0;
+    size_t depth = 0;
+
+    for (size_t i = 0; i < _events.size(); ++i) {
+        const auto& event = _events[i];
+
+        switch (event.type) {
+            case NoticeRecorder::EventType::Send: {
+                const auto& notice = notices[index++];
+
+                // Look ahead for the decision taken by the recorded
+                // predicate.
+                decision = true;
+                if (i + 1 < _events.size()
+                    && _events[i + 1].type
+                           == NoticeRecorder::EventType::Capture) {
+                    decision = NoticeReader::DecodeUInt32(
+                                   _data.data() + _events[i + 1].offset)
+                               != 0;
+                }
+
+                if (notice) {
+                    broker->Send(notice);
+                    sent++;
+                }
+                break;
+            }
+            case NoticeRecorder::EventType::BeginTransaction:
+                broker->BeginTransaction(predicate);
+                depth++;
+                break;
+            case NoticeRecorder::EventType::EndTransaction:
+                // Ignore transactions started before the recording.
+                if (depth > 0) {
+                    broker->EndTransaction();
+                    depth--;
+                }
+                break;
+            case NoticeRecorder::EventType::Capture:
+                break;
+        }
+    }
+
+    // Close transactions which were still opened when the recording stopped.
+    for (; depth > 0; --depth) {
+        broker->EndTransaction();
+    }
+
+    return sent;
+}
+
+}  // namespace unf
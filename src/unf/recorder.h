@@ -0,0 +1,163 @@
+#ifndef USD_NOTICE_FRAMEWORK_RECORDER_H
+#define USD_NOTICE_FRAMEWORK_RECORDER_H
+
+/// \file unf/recorder.h
+
+#include "unf/api.h"
+#include "unf/broker.h"
+#include "unf/notice.h"
+
+#include <pxr/pxr.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace unf {
+
+/// \class NoticeRecorder
+///
+/// \brief
+/// Record the stream of notices handled by a Broker into a file.
+///
+/// Each notice sent via the broker, each transaction boundary and each
+/// decision taken by the capture predicate of the current transaction are
+/// written in order, so that the session can be replayed with
+/// NoticeRecording.
+///
+/// \code{.cpp}
+/// auto broker = unf::Broker::Create(stage);
+///
+/// {
+///     unf::NoticeRecorder recorder(broker, "/tmp/session.unfr");
+///
+///     // Edit stage...
+/// }
+/// \endcode
+///
+/// Notices captured by a transaction are recorded after being trimmed by
+/// its capture predicate, so that replaying the recording merges the same
+/// content.
+///
+/// \note
+/// Notices are serialized with NoticeSerializer. Notices which cannot be
+/// serialized are recorded without content and ignored during replay.
+class NoticeRecorder {
+  public:
+    /// Type of event recorded.
+    enum class EventType : uint32_t {
+        Send = 1,
+        BeginTransaction = 2,
+        EndTransaction = 3,
+        Capture = 4,
+    };
+
+    /// \brief
+    /// Start recording notices handled by \p broker into \p filePath.
+    ///
+    /// Only one recorder can be attached to a broker at a time.
+    ///
+    /// The recorder does not keep \p broker alive. A coding error is
+    /// raised if \p broker is invalid.
+    UNF_API NoticeRecorder(
+        const BrokerWeakPtr& broker, const std::string& filePath);
+
+    /// Stop recording and close file.
+    UNF_API virtual ~NoticeRecorder();
+
+    /// Remove default copy constructor.
+    UNF_API NoticeRecorder(const NoticeRecorder&) = delete;
+
+    /// Remove default assignment operator.
+    UNF_API NoticeRecorder& operator=(const NoticeRecorder&) = delete;
+
+    /// Indicate whether the recorder is attached to the broker.
+    bool IsRecording() const { return _recording; }
+
+    /// Return number of events recorded.
+    size_t GetEventCount() const { return _eventCount; }
+
+    /// \brief
+    /// Stop recording and close file.
+    ///
+    /// The recorder cannot be restarted.
+    UNF_API void Stop();
+
+  private:
+    /// Record notice sent via the broker.
+    void _RecordSend(const UnfNotice::StageNoticeRefPtr&);
+
+    /// Record start of transaction.
+    void _RecordBeginTransaction();
+
+    /// Record end of transaction.
+    void _RecordEndTransaction();
+
+    /// Record whether the last notice sent was captured.
+    void _RecordCapture(bool captured);
+
+    /// Write event of \p type with \p data into the file.
+    void _Write(EventType type, const std::vector<char>& data = {});
+
+    BrokerWeakPtr _broker;
+    std::ofstream _stream;
+    size_t _eventCount = 0;
+    bool _recording = false;
+
+    friend class Broker;
+};
+
+/// \class NoticeRecording
+///
+/// \brief
+/// Read a file written by NoticeRecorder and replay it through a Broker.
+///
+/// The recording is loaded in memory once, so that it can be replayed
+/// several times at full speed to profile the broker and its listeners.
+class NoticeRecording {
+  public:
+    /// \brief
+    /// Load recording from \p filePath.
+    ///
+    /// A runtime error is raised if the file cannot be read.
+    UNF_API explicit NoticeRecording(const std::string& filePath);
+
+    /// Indicate whether the recording was loaded successfully.
+    bool IsValid() const { return _valid; }
+
+    /// Return number of events recorded.
+    size_t GetEventCount() const { return _events.size(); }
+
+    /// Return number of notices recorded.
+    UNF_API size_t GetNoticeCount() const;
+
+    /// \brief
+    /// Replay recording through \p broker.
+    ///
+    /// Recorded notices are re-created and sent with Broker::Send, and
+    /// transactions are started and ended with Broker::BeginTransaction and
+    /// Broker::EndTransaction. Each transaction uses a capture predicate
+    /// which returns the recorded decisions in order. Notices were recorded
+    /// after being trimmed, so the predicate does not trim them again.
+    ///
+    /// Notices are deserialized before being sent so that their cost is not
+    /// included within the replay. Return the number of notices sent.
+    UNF_API size_t Replay(const BrokerPtr& broker) const;
+
+  private:
+    struct _Event {
+        NoticeRecorder::EventType type;
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<char> _data;
+    std::vector<_Event> _events;
+    bool _valid = false;
+};
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_RECORDER_H
@@ -0,0 +1,665 @@
+#include "unf/serialization.h"
+#include "unf/notice.h"
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace unf {
+
+namespace {
+
+// Magic number identifying serialized notices.
+constexpr char _magic[4] = {'U', 'N', 'F', 'N'};
+
+// Size of the header (magic number, version, record count, reserved).
+constexpr size_t _headerSize = 16;
+
+// Number of 32-bit integers per record entry (type identifier, data and
+// dictionary offsets and sizes).
+constexpr size_t _recordFields = 6;
+
+// Number of path table entries between two restart points.
+constexpr uint32_t _restartInterval = 16;
+
+void _AppendUInt32(std::vector<char>& data, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void _SetUInt32(std::vector<char>& data, size_t offset, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void _Align(std::vector<char>& data)
+{
+    while (data.size() % 4 != 0) data.push_back('\0');
+}
+
+void _Append(std::vector<char>& target, const std::vector<char>& source)
+{
+    target.insert(target.end(), source.begin(), source.end());
+}
+
+template <class T>
+void _Define(std::unordered_map<std::string, NoticeDeserializerFunc>& registry)
+{
+    registry[ArchGetDemangled(typeid(T).name())] = [](NoticeReader& reader) {
+        return UnfNotice::StageNoticeRefPtr(T::Deserialize(reader));
+    };
+}
+
+}  // anonymous namespace
+
+void NoticeWriter::WriteUInt32(uint32_t value) { _AppendUInt32(_data, value); }
+
+void NoticeWriter::WriteUInt64(uint64_t value)
+{
+    WriteUInt32(static_cast<uint32_t>(value & 0xFFFFFFFF));
+    WriteUInt32(static_cast<uint32_t>(value >> 32));
+}
+
+void NoticeWriter::WriteString(const std::string& value)
+{
+    WriteUInt32(static_cast<uint32_t>(value.size()));
+    _data.insert(_data.end(), value.begin(), value.end());
+}
+
+void NoticeWriter::WriteStrings(const std::vector<std::string>& values)
+{
+    WriteUInt32(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+        WriteString(value);
+    }
+}
+
+void NoticeWriter::WriteToken(const TfToken& token)
+{
+    WriteUInt32(GetTokenIndex(token));
+}
+
+uint32_t NoticeWriter::GetTokenIndex(const TfToken& token)
+{
+    auto it = _tokenIndices.find(token);
+    if (it != _tokenIndices.end()) return it->second;
+
+    uint32_t index = static_cast<uint32_t>(_tokens.size());
+    _tokens.push_back(token);
+    _tokenIndices.emplace(token, index);
+    return index;
+}
+
+void NoticeWriter::WriteUInt32Array(const std::vector<uint32_t>& values)
+{
+    WriteUInt32(static_cast<uint32_t>(values.size()));
+    for (uint32_t value : values) {
+        WriteUInt32(value);
+    }
+}
+
+void NoticeWriter::SortPaths(SdfPathVector* paths)
+{
+    std::sort(
+        paths->begin(), paths->end(), [](const SdfPath& a, const SdfPath& b) {
+            return a.GetString() < b.GetString();
+        });
+    paths->erase(std::unique(paths->begin(), paths->end()), paths->end());
+}
+
+void NoticeWriter::WritePaths(const SdfPathVector& paths)
+{
+    SdfPathVector sortedPaths(paths);
+    SortPaths(&sortedPaths);
+
+    std::vector<char> entries;
+    std::vector<uint32_t> restarts;
+    std::string previous;
+
+    for (size_t i = 0; i < sortedPaths.size(); ++i) {
+        const std::string& key = sortedPaths[i].GetString();
+
+        // Restart points record the full key so that the table can be
+        // searched by bisection.
+        size_t shared = 0;
+        if (i % _restartInterval == 0) {
+            restarts.push_back(static_cast<uint32_t>(entries.size()));
+        }
+        else {
+            const size_t limit = std::min(previous.size(), key.size());
+            while (shared < limit && previous[shared] == key[shared]) {
+                ++shared;
+            }
+        }
+
+        _AppendUInt32(entries, static_cast<uint32_t>(shared));
+        _AppendUInt32(entries, static_cast<uint32_t>(key.size() - shared));
+        entries.insert(entries.end(), key.begin() + shared, key.end());
+
+        previous = key;
+    }
+
+    WriteUInt32(static_cast<uint32_t>(sortedPaths.size()));
+    WriteUInt32(_restartInterval);
+    WriteUInt32Array(restarts);
+    WriteUInt32(static_cast<uint32_t>(entries.size()));
+    _Append(_data, entries);
+}
+
+SdfPath SerializedPathTable::GetPath(size_t index) const
+{
+    if (index >= _count) return SdfPath();
+    return SdfPath(_GetKey(index));
+}
+
+SdfPathVector SerializedPathTable::GetPaths() const
+{
+    SdfPathVector paths;
+    paths.reserve(_count);
+
+    std::string key;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < _count; ++i) {
+        if (offset + 8 > _entriesSize) break;
+
+        const uint32_t shared = NoticeReader::DecodeUInt32(_entries + offset);
+        const uint32_t size = NoticeReader::DecodeUInt32(_entries + offset, 1);
+        offset += 8;
+
+        if (shared > key.size() || offset + size > _entriesSize) break;
+
+        key.resize(shared);
+        key.append(_entries + offset, size);
+        offset += size;
+
+        paths.push_back(SdfPath(key));
+    }
+
+    return paths;
+}
+
+std::string SerializedPathTable::_GetRestartKey(size_t restart) const
+{
+    const size_t offset = NoticeReader::DecodeUInt32(_restarts, restart);
+    if (offset + 8 > _entriesSize) return std::string();
+
+    const uint32_t size = NoticeReader::DecodeUInt32(_entries + offset, 1);
+    if (offset + 8 + size > _entriesSize) return std::string();
+
+    return std::string(_entries + offset + 8, size);
+}
+
+std::string SerializedPathTable::_GetKey(size_t index) const
+{
+    const size_t restart = index / _interval;
+    if (restart >= _restartCount) return std::string();
+
+    std::string key;
+    size_t offset = NoticeReader::DecodeUInt32(_restarts, restart);
+
+    for (size_t i = restart * _interval; i <= index; ++i) {
+        if (offset + 8 > _entriesSize) return std::string();
+
+        const uint32_t shared = NoticeReader::DecodeUInt32(_entries + offset);
+        const uint32_t size = NoticeReader::DecodeUInt32(_entries + offset, 1);
+        offset += 8;
+
+        if (shared > key.size() || offset + size > _entriesSize) {
+            return std::string();
+        }
+
+        key.resize(shared);
+        key.append(_entries + offset, size);
+        offset += size;
+    }
+
+    return key;
+}
+
+size_t SerializedPathTable::Find(const SdfPath& path) const
+{
+    if (_count == 0 || _restartCount == 0) return _count;
+
+    const std::string& target = path.GetString();
+
+    // Find the last restart point with a key lower or equal to the target.
+    size_t low = 0;
+    size_t high = _restartCount;
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+        if (_GetRestartKey(middle) <= target) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    // Scan entries until the next restart point.
+    std::string key;
+    size_t offset = NoticeReader::DecodeUInt32(_restarts, low);
+    const size_t end = std::min(_count, (low + 1) * _interval);
+
+    for (size_t i = low * _interval; i < end; ++i) {
+        if (offset + 8 > _entriesSize) break;
+
+        const uint32_t shared = NoticeReader::DecodeUInt32(_entries + offset);
+        const uint32_t size = NoticeReader::DecodeUInt32(_entries + offset, 1);
+        offset += 8;
+
+        if (shared > key.size() || offset + size > _entriesSize) break;
+
+        key.resize(shared);
+        key.append(_entries + offset, size);
+        offset += size;
+
+        if (key == target) return i;
+        if (key > target) break;
+    }
+
+    return _count;
+}
+
+bool SerializedPathTable::ContainsPrefixOf(const SdfPath& path) const
+{
+    if (_count == 0) return false;
+
+    for (SdfPath prefix = path; !prefix.IsEmpty();
+         prefix = prefix.GetParentPath()) {
+        if (Contains(prefix)) return true;
+    }
+
+    return false;
+}
+
+NoticeReader::NoticeReader(
+    const char* data,
+    size_t size,
+    const char* dictionary,
+    size_t dictionarySize)
+    : _data(data),
+      _size(size),
+      _dictionary(dictionary),
+      _dictionarySize(dictionarySize)
+{
+}
+
+const char* NoticeReader::_Consume(size_t size)
+{
+    if (!_valid || size > _size - _offset) {
+        _valid = false;
+        return nullptr;
+    }
+
+    const char* data = _data + _offset;
+    _offset += size;
+    return data;
+}
+
+uint32_t NoticeReader::DecodeUInt32(const char* data, size_t index)
+{
+    const auto* bytes =
+        reinterpret_cast<const unsigned char*>(data + index * 4);
+    return static_cast<uint32_t>(bytes[0])
+           | (static_cast<uint32_t>(bytes[1]) << 8)
+           | (static_cast<uint32_t>(bytes[2]) << 16)
+           | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+uint32_t NoticeReader::ReadUInt32()
+{
+    const char* data = _Consume(4);
+    if (!data) return 0;
+    return DecodeUInt32(data);
+}
+
+uint64_t NoticeReader::ReadUInt64()
+{
+    const uint64_t low = ReadUInt32();
+    const uint64_t high = ReadUInt32();
+    return low | (high << 32);
+}
+
+std::string NoticeReader::ReadString()
+{
+    const uint32_t size = ReadUInt32();
+    const char* data = _Consume(size);
+    if (!data) return std::string();
+    return std::string(data, size);
+}
+
+std::vector<std::string> NoticeReader::ReadStrings()
+{
+    std::vector<std::string> values;
+
+    const uint32_t count = ReadUInt32();
+    for (uint32_t i = 0; i < count && _valid; ++i) {
+        values.push_back(ReadString());
+    }
+
+    return values;
+}
+
+TfToken NoticeReader::GetToken(uint32_t index) const
+{
+    if (_dictionarySize < 4) return TfToken();
+
+    const uint32_t count = DecodeUInt32(_dictionary);
+    if (index >= count || 4 + (size_t(count) * 8) > _dictionarySize) {
+        return TfToken();
+    }
+
+    const uint32_t offset = DecodeUInt32(_dictionary, 1 + index * 2);
+    const uint32_t size = DecodeUInt32(_dictionary, 2 + index * 2);
+    if (size_t(offset) + size > _dictionarySize) return TfToken();
+
+    return TfToken(std::string(_dictionary + offset, size));
+}
+
+TfToken NoticeReader::ReadToken() { return GetToken(ReadUInt32()); }
+
+std::vector<uint32_t> NoticeReader::ReadUInt32Array()
+{
+    size_t count = 0;
+    const char* data = ReadUInt32ArrayInPlace(&count);
+
+    std::vector<uint32_t> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(DecodeUInt32(data, i));
+    }
+
+    return values;
+}
+
+const char* NoticeReader::ReadUInt32ArrayInPlace(size_t* count)
+{
+    const uint32_t size = ReadUInt32();
+    const char* data = _Consume(size_t(size) * 4);
+
+    *count = data ? size : 0;
+    return data;
+}
+
+SerializedPathTable NoticeReader::ReadPaths()
+{
+    SerializedPathTable table;
+
+    const uint32_t count = ReadUInt32();
+    const uint32_t interval = ReadUInt32();
+
+    size_t restartCount = 0;
+    const char* restarts = ReadUInt32ArrayInPlace(&restartCount);
+
+    const uint32_t entriesSize = ReadUInt32();
+    const char* entries = _Consume(entriesSize);
+
+    // Ensure that restart points cover all entries before exposing table.
+    if (!_valid || interval == 0
+        || restartCount != (count + interval - 1) / interval) {
+        _valid = false;
+        return table;
+    }
+
+    table._restarts = restarts;
+    table._entries = entries;
+    table._entriesSize = entriesSize;
+    table._count = count;
+    table._restartCount = restartCount;
+    table._interval = interval;
+    return table;
+}
+
+void NoticeSerializer::Register(
+    const std::string& typeId, const NoticeDeserializerFunc& function)
+{
+    _GetRegistry()[typeId] = function;
+}
+
+NoticeDeserializerFunc NoticeSerializer::Find(const std::string& typeId)
+{
+    const auto& registry = _GetRegistry();
+
+    auto it = registry.find(typeId);
+    if (it == registry.end()) return nullptr;
+
+    return it->second;
+}
+
+std::unordered_map<std::string, NoticeDeserializerFunc>&
+NoticeSerializer::_GetRegistry()
+{
+    static std::unordered_map<std::string, NoticeDeserializerFunc> registry =
+        []() {
+            std::unordered_map<std::string, NoticeDeserializerFunc> _registry;
+            _Define<UnfNotice::StageContentsChanged>(_registry);
+            _Define<UnfNotice::ObjectsChanged>(_registry);
+            _Define<UnfNotice::StageEditTargetChanged>(_registry);
+            _Define<UnfNotice::LayerMutingChanged>(_registry);
+            _Define<UnfNotice::LayersChanged>(_registry);
+            return _registry;
+        }();
+
+    return registry;
+}
+
+std::vector<char> NoticeSerializer::Serialize(
+    const std::vector<UnfNotice::StageNoticeRefPtr>& notices)
+{
+    std::vector<std::string> typeIds;
+    std::vector<NoticeWriter> writers;
+
+    for (const auto& notice : notices) {
+        NoticeWriter writer;
+        if (!notice->Serialize(writer)) continue;
+
+        typeIds.push_back(notice->GetTypeId());
+        writers.push_back(std::move(writer));
+    }
+
+    std::vector<char> buffer;
+    buffer.insert(buffer.end(), std::begin(_magic), std::end(_magic));
+    _AppendUInt32(buffer, Version);
+    _AppendUInt32(buffer, static_cast<uint32_t>(writers.size()));
+    _AppendUInt32(buffer, 0);
+
+    // Reserve record table which is filled once sections are written.
+    const size_t tableOffset = buffer.size();
+    buffer.resize(tableOffset + writers.size() * _recordFields * 4, '\0');
+
+    for (size_t i = 0; i < writers.size(); ++i) {
+        const size_t record = tableOffset + i * _recordFields * 4;
+
+        _SetUInt32(buffer, record, static_cast<uint32_t>(buffer.size()));
+        _SetUInt32(
+            buffer, record + 4, static_cast<uint32_t>(typeIds[i].size()));
+        buffer.insert(buffer.end(), typeIds[i].begin(), typeIds[i].end());
+        _Align(buffer);
+
+        const auto& data = writers[i].GetData();
+        _SetUInt32(buffer, record + 8, static_cast<uint32_t>(buffer.size()));
+        _SetUInt32(buffer, record + 12, static_cast<uint32_t>(data.size()));
+        _Append(buffer, data);
+        _Align(buffer);
+
+        // Dictionary section starts with the number of tokens, followed by
+        // the offset and size of each token relative to the section.
+        const auto& tokens = writers[i].GetTokens();
+        std::vector<char> dictionary;
+        _AppendUInt32(dictionary, static_cast<uint32_t>(tokens.size()));
+
+        size_t offset = 4 + tokens.size() * 8;
+        for (const auto& token : tokens) {
+            _AppendUInt32(dictionary, static_cast<uint32_t>(offset));
+            _AppendUInt32(
+                dictionary, static_cast<uint32_t>(token.GetString().size()));
+            offset += token.GetString().size();
+        }
+        for (const auto& token : tokens) {
+            const std::string& name = token.GetString();
+            dictionary.insert(dictionary.end(), name.begin(), name.end());
+        }
+
+        _SetUInt32(buffer, record + 16, static_cast<uint32_t>(buffer.size()));
+        _SetUInt32(
+            buffer, record + 20, static_cast<uint32_t>(dictionary.size()));
+        _Append(buffer, dictionary);
+        _Align(buffer);
+    }
+
+    return buffer;
+}
+
+SerializedNotices::SerializedNotices(const char* data, size_t size)
+    : _data(data), _size(size)
+{
+    if (!_data || _size < _headerSize
+        || std::memcmp(_data, _magic, sizeof(_magic)) != 0) {
+        TF_RUNTIME_ERROR("Buffer does not contain serialized notices.");
+        return;
+    }
+
+    _version = NoticeReader::DecodeUInt32(_data, 1);
+    if (_version != NoticeSerializer::Version) {
+        TF_RUNTIME_ERROR(
+            "Unsupported serialized notices version: %u", _version);
+        return;
+    }
+
+    _count = NoticeReader::DecodeUInt32(_data, 2);
+    if ((_size - _headerSize) / (_recordFields * 4) < _count) {
+        TF_RUNTIME_ERROR("Serialized notices buffer is truncated.");
+        _count = 0;
+        return;
+    }
+
+    // Ensure that all sections referenced by the record table are within
+    // the buffer.
+    for (size_t i = 0; i < _count; ++i) {
+        const char* record = _GetRecord(i);
+        for (size_t field = 0; field < _recordFields; field += 2) {
+            const size_t offset = NoticeReader::DecodeUInt32(record, field);
+            const size_t size = NoticeReader::DecodeUInt32(record, field + 1);
+            if (offset > _size || size > _size - offset) {
+                TF_RUNTIME_ERROR("Serialized notices buffer is truncated.");
+                _count = 0;
+                return;
+            }
+        }
+    }
+
+    _valid = true;
+}
+
+SerializedNotices::SerializedNotices(const std::vector<char>& buffer)
+    : SerializedNotices(buffer.data(), buffer.size())
+{
+}
+
+const char* SerializedNotices::_GetRecord(size_t index) const
+{
+    return _data + _headerSize + index * _recordFields * 4;
+}
+
+std::string SerializedNotices::GetTypeId(size_t index) const
+{
+    if (index >= _count) return std::string();
+
+    const char* record = _GetRecord(index);
+    return std::string(
+        _data + NoticeReader::DecodeUInt32(record, 0),
+        NoticeReader::DecodeUInt32(record, 1));
+}
+
+NoticeReader SerializedNotices::GetReader(size_t index) const
+{
+    if (index >= _count) return NoticeReader(nullptr, 0, nullptr, 0);
+
+    const char* record = _GetRecord(index);
+    return NoticeReader(
+        _data + NoticeReader::DecodeUInt32(record, 2),
+        NoticeReader::DecodeUInt32(record, 3),
+        _data + NoticeReader::DecodeUInt32(record, 4),
+        NoticeReader::DecodeUInt32(record, 5));
+}
+
+UnfNotice::StageNoticeRefPtr SerializedNotices::Deserialize(size_t index) const
+{
+    const auto function = NoticeSerializer::Find(GetTypeId(index));
+    if (!function) return nullptr;
+
+    NoticeReader reader = GetReader(index);
+    auto notice = function(reader);
+
+    if (!reader.IsValid()) {
+        TF_RUNTIME_ERROR(
+            "Failed to deserialize notice %s.", GetTypeId(index).c_str());
+        return nullptr;
+    }
+
+    return notice;
+}
+
+std::vector<UnfNotice::StageNoticeRefPtr> SerializedNotices::DeserializeAll()
+    const
+{
+    std::vector<UnfNotice::StageNoticeRefPtr> notices;
+    notices.reserve(_count);
+
+    for (size_t i = 0; i < _count; ++i) {
+        auto notice = Deserialize(i);
+        if (notice) notices.push_back(notice);
+    }
+
+    return notices;
+}
+
+ObjectsChangedView::ObjectsChangedView(NoticeReader reader) : _reader(reader)
+{
+    _resyncChanges = _reader.ReadPaths();
+    _infoChanges = _reader.ReadPaths();
+    _fieldPaths = _reader.ReadPaths();
+
+    size_t offsetCount = 0;
+    _fieldOffsets = _reader.ReadUInt32ArrayInPlace(&offsetCount);
+    _fieldTokens = _reader.ReadUInt32ArrayInPlace(&_fieldTokenCount);
+
+    if (offsetCount != _fieldPaths.size() + 1) {
+        _fieldPaths = SerializedPathTable();
+        _fieldOffsets = nullptr;
+    }
+}
+
+TfTokenSet ObjectsChangedView::GetChangedFields(const SdfPath& path) const
+{
+    TfTokenSet tokens;
+
+    const size_t index = _fieldPaths.Find(path);
+    if (index == _fieldPaths.size() || !_fieldOffsets) return tokens;
+
+    const size_t begin = NoticeReader::DecodeUInt32(_fieldOffsets, index);
+    const size_t end = NoticeReader::DecodeUInt32(_fieldOffsets, index + 1);
+
+    for (size_t i = begin; i < end && i < _fieldTokenCount; ++i) {
+        tokens.insert(
+            _reader.GetToken(NoticeReader::DecodeUInt32(_fieldTokens, i)));
+    }
+
+    return tokens;
+}
+
+}  // namespace unf
@@ -0,0 +1,409 @@
+#ifndef USD_NOTICE_FRAMEWORK_SERIALIZATION_H
+#define USD_NOTICE_FRAMEWORK_SERIALIZATION_H
+
+/// \file unf/serialization.h
+
+#include "unf/api.h"
+#include "unf/notice.h"
+
+#include <pxr/base/arch/demangle.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace unf {
+
+/// \class NoticeWriter
+///
+/// \brief
+/// Encoder used to write the content of a UnfNotice::StageNotice into a
+/// binary buffer.
+///
+/// Integers are written in little-endian byte order. Tokens are
+/// dictionary-encoded per notice, and path vectors are written as sorted
+/// prefix-compressed tables which can be queried without being decoded.
+///
+/// \sa UnfNotice::StageNotice::Serialize
+class NoticeWriter {
+  public:
+    UNF_API NoticeWriter() = default;
+
+    /// Write unsigned 32-bit integer.
+    UNF_API void WriteUInt32(uint32_t);
+
+    /// Write unsigned 64-bit integer.
+    UNF_API void WriteUInt64(uint64_t);
+
+    /// Write string prefixed by its size.
+    UNF_API void WriteString(const std::string&);
+
+    /// Write vector of strings prefixed by its size.
+    UNF_API void WriteStrings(const std::vector<std::string>&);
+
+    /// Write index of \p token within the notice dictionary.
+    UNF_API void WriteToken(const PXR_NS::TfToken& token);
+
+    /// \brief
+    /// Return index of \p token within the notice dictionary.
+    ///
+    /// The token is added to the dictionary if necessary.
+    UNF_API uint32_t GetTokenIndex(const PXR_NS::TfToken& token);
+
+    /// Write vector of unsigned 32-bit integers prefixed by its size.
+    UNF_API void WriteUInt32Array(const std::vector<uint32_t>&);
+
+    /// \brief
+    /// Write table of \p paths.
+    ///
+    /// Paths are sorted in string order and deduplicated before being
+    /// prefix-compressed, with a restart point every 16 entries so that the
+    /// table can be searched in place.
+    ///
+    /// \sa SortPaths
+    UNF_API void WritePaths(const PXR_NS::SdfPathVector& paths);
+
+    /// \brief
+    /// Sort \p paths in the order used by path tables and remove duplicates.
+    ///
+    /// Data associated with each path of a table should be written following
+    /// this order.
+    UNF_API static void SortPaths(PXR_NS::SdfPathVector* paths);
+
+    /// Return encoded data.
+    const std::vector<char>& GetData() const { return _data; }
+
+    /// Return token dictionary in index order.
+    const std::vector<PXR_NS::TfToken>& GetTokens() const { return _tokens; }
+
+  private:
+    std::vector<char> _data;
+    std::vector<PXR_NS::TfToken> _tokens;
+    std::unordered_map<PXR_NS::TfToken, uint32_t, PXR_NS::TfToken::HashFunctor>
+        _tokenIndices;
+};
+
+/// \class SerializedPathTable
+///
+/// \brief
+/// Read-only view over a prefix-compressed path table.
+///
+/// The view references the serialized buffer, which must outlive it.
+class SerializedPathTable {
+  public:
+    /// Create an empty table.
+    UNF_API SerializedPathTable() = default;
+
+    /// Return number of paths in table.
+    size_t size() const { return _count; }
+
+    /// Indicate whether the table is empty.
+    bool empty() const { return _count == 0; }
+
+    /// Decode and return path at \p index.
+    UNF_API PXR_NS::SdfPath GetPath(size_t index) const;
+
+    /// Decode and return all paths in table order.
+    UNF_API PXR_NS::SdfPathVector GetPaths() const;
+
+    /// \brief
+    /// Return index of \p path within the table, or size() if the path is
+    /// not in the table.
+    UNF_API size_t Find(const PXR_NS::SdfPath& path) const;
+
+    /// Indicate whether \p path is in the table.
+    bool Contains(const PXR_NS::SdfPath& path) const
+    {
+        return Find(path) != _count;
+    }
+
+    /// Indicate whether \p path or one of its ancestors is in the table.
+    UNF_API bool ContainsPrefixOf(const PXR_NS::SdfPath& path) const;
+
+  private:
+    /// Decode string key at \p index.
+    std::string _GetKey(size_t index) const;
+
+    /// Decode full string key located at restart point \p restart.
+    std::string _GetRestartKey(size_t restart) const;
+
+    const char* _restarts = nullptr;
+    const char* _entries = nullptr;
+    size_t _entriesSize = 0;
+    size_t _count = 0;
+    size_t _restartCount = 0;
+    size_t _interval = 0;
+
+    friend class NoticeReader;
+};
+
+/// \class NoticeReader
+///
+/// \brief
+/// Decoder used to read the content of a UnfNotice::StageNotice from a binary
+/// buffer written by NoticeWriter.
+///
+/// The reader does not copy the buffer, which must outlive the reader and
+/// all views created from it. Reading past the end of the buffer
+/// invalidates the reader and returns default values.
+class NoticeReader {
+  public:
+    /// Create reader from encoded data and token dictionary.
+    UNF_API NoticeReader(
+        const char* data,
+        size_t size,
+        const char* dictionary,
+        size_t dictionarySize);
+
+    /// Indicate whether all data read so far was valid.
+    bool IsValid() const { return _valid; }
+
+    /// Indicate whether all data has been read.
+    bool AtEnd() const { return _offset >= _size; }
+
+    /// Read unsigned 32-bit integer.
+    UNF_API uint32_t ReadUInt32();
+
+    /// Read unsigned 64-bit integer.
+    UNF_API uint64_t ReadUInt64();
+
+    /// Read string.
+    UNF_API std::string ReadString();
+
+    /// Read vector of strings.
+    UNF_API std::vector<std::string> ReadStrings();
+
+    /// Read token from the notice dictionary.
+    UNF_API PXR_NS::TfToken ReadToken();
+
+    /// Return token at \p index within the notice dictionary.
+    UNF_API PXR_NS::TfToken GetToken(uint32_t index) const;
+
+    /// Read vector of unsigned 32-bit integers.
+    UNF_API std::vector<uint32_t> ReadUInt32Array();
+
+    /// \brief
+    /// Read vector of unsigned 32-bit integers without copying.
+    ///
+    /// Return pointer to the first encoded integer and set \p count to the
+    /// number of integers. Each integer should be decoded with
+    /// DecodeUInt32.
+    UNF_API const char* ReadUInt32ArrayInPlace(size_t* count);
+
+    /// Read path table without decoding it.
+    UNF_API SerializedPathTable ReadPaths();
+
+    /// Decode unsigned 32-bit integer at \p index from \p data.
+    UNF_API static uint32_t DecodeUInt32(const char* data, size_t index = 0);
+
+  private:
+    /// Return pointer to the next \p size bytes and advance, or nullptr if
+    /// the buffer is too small.
+    const char* _Consume(size_t size);
+
+    const char* _data;
+    size_t _size;
+    size_t _offset = 0;
+
+    const char* _dictionary;
+    size_t _dictionarySize;
+
+    bool _valid = true;
+};
+
+/// Convenient alias for function creating notice from a NoticeReader.
+using NoticeDeserializerFunc =
+    std::function<UnfNotice::StageNoticeRefPtr(NoticeReader&)>;
+
+/// \class NoticeSerializer
+///
+/// \brief
+/// Registry of functions used to re-create notices from serialized data.
+///
+/// Notices provided by the library are registered by default. Custom notices
+/// can be registered via NoticeSerializationDefine.
+class NoticeSerializer {
+  public:
+    /// Current version of the binary encoding.
+    static constexpr uint32_t Version = 1;
+
+    /// Register deserializer \p function for notice type \p typeId.
+    UNF_API static void Register(
+        const std::string& typeId, const NoticeDeserializerFunc& function);
+
+    /// Return deserializer registered for \p typeId, or nullptr.
+    UNF_API static NoticeDeserializerFunc Find(const std::string& typeId);
+
+    /// \brief
+    /// Serialize \p notices into a versioned binary buffer.
+    ///
+    /// Notices which cannot be serialized are skipped.
+    ///
+    /// \sa UnfNotice::StageNotice::Serialize
+    UNF_API static std::vector<char> Serialize(
+        const std::vector<UnfNotice::StageNoticeRefPtr>& notices);
+
+  private:
+    static std::unordered_map<std::string, NoticeDeserializerFunc>&
+    _GetRegistry();
+};
+
+/// \class SerializedNotices
+///
+/// \brief
+/// Read-only view over a buffer created by NoticeSerializer::Serialize.
+///
+/// The buffer can be memory-mapped and queried without being copied. It
+/// must outlive the view and all readers created from it.
+///
+/// The buffer starts with a header ("UNFN" magic number, version and number
+/// of records), followed by a table locating the type identifier, data and
+/// token dictionary of each record.
+class SerializedNotices {
+  public:
+    /// Create view from buffer \p data of \p size bytes.
+    UNF_API SerializedNotices(const char* data, size_t size);
+
+    /// Create view from \p buffer.
+    UNF_API explicit SerializedNotices(const std::vector<char>& buffer);
+
+    /// Indicate whether the header is valid and supported.
+    bool IsValid() const { return _valid; }
+
+    /// Return version of the encoding.
+    uint32_t GetVersion() const { return _version; }
+
+    /// Return number of serialized notices.
+    size_t size() const { return _count; }
+
+    /// Return type identifier of the notice at \p index.
+    UNF_API std::string GetTypeId(size_t index) const;
+
+    /// Create a reader for the notice at \p index.
+    UNF_API NoticeReader GetReader(size_t index) const;
+
+    /// \brief
+    /// Re-create notice at \p index.
+    ///
+    /// Return a null pointer if no deserializer is registered for this type.
+    UNF_API UnfNotice::StageNoticeRefPtr Deserialize(size_t index) const;
+
+    /// Re-create all notices which can be deserialized.
+    UNF_API std::vector<UnfNotice::StageNoticeRefPtr> DeserializeAll() const;
+
+  private:
+    /// Return pointer to record entry at \p index.
+    const char* _GetRecord(size_t index) const;
+
+    const char* _data;
+    size_t _size;
+    uint32_t _version = 0;
+    size_t _count = 0;
+    bool _valid = false;
+};
+
+/// \class ObjectsChangedView
+///
+/// \brief
+/// Query serialized UnfNotice::ObjectsChanged data without deserializing it.
+class ObjectsChangedView {
+  public:
+    /// Create view from \p reader positioned at the start of the notice.
+    UNF_API explicit ObjectsChangedView(NoticeReader reader);
+
+    /// Indicate whether the data was read successfully.
+    bool IsValid() const { return _reader.IsValid(); }
+
+    /// Indicate whether \p path was affected.
+    bool AffectedPath(const PXR_NS::SdfPath& path) const
+    {
+        return ResyncedPath(path) || ChangedInfoOnly(path);
+    }
+
+    /// Indicate whether \p path or one of its ancestors was resynced.
+    bool ResyncedPath(const PXR_NS::SdfPath& path) const
+    {
+        return _resyncChanges.ContainsPrefixOf(path);
+    }
+
+    /// Indicate whether \p path or one of its ancestors changed info only.
+    bool ChangedInfoOnly(const PXR_NS::SdfPath& path) const
+    {
+        return _infoChanges.ContainsPrefixOf(path);
+    }
+
+    /// Return table of resynced paths.
+    const SerializedPathTable& GetResyncedPaths() const
+    {
+        return _resyncChanges;
+    }
+
+    /// Return table of paths modified but not resynced.
+    const SerializedPathTable& GetChangedInfoOnlyPaths() const
+    {
+        return _infoChanges;
+    }
+
+    /// Indicate whether any changed fields affected \p path.
+    bool HasChangedFields(const PXR_NS::SdfPath& path) const
+    {
+        return _fieldPaths.Contains(path);
+    }
+
+    /// Return the set of changed fields that affected \p path.
+    UNF_API TfTokenSet GetChangedFields(const PXR_NS::SdfPath& path) const;
+
+  private:
+    NoticeReader _reader;
+    SerializedPathTable _resyncChanges;
+    SerializedPathTable _infoChanges;
+    SerializedPathTable _fieldPaths;
+    const char* _fieldOffsets = nullptr;
+    const char* _fieldTokens = nullptr;
+    size_t _fieldTokenCount = 0;
+};
+
+/// \fn NoticeSerializationDefine
+///
+/// \brief
+/// Register deserializer for a specific type of notice.
+///
+/// The notice type \p T must override UnfNotice::StageNotice::Serialize and
+/// provide a static Deserialize method as follows:
+///
+/// \code{.cpp}
+/// class Foo : public unf::UnfNotice::StageNoticeImpl<Foo> {
+///   public:
+///     bool Serialize(unf::NoticeWriter& writer) const override;
+///     static PXR_NS::TfRefPtr<Foo> Deserialize(unf::NoticeReader& reader);
+/// };
+///
+/// TF_REGISTRY_FUNCTION(PXR_NS::TfType)
+/// {
+///     unf::NoticeSerializationDefine<Foo>();
+/// }
+/// \endcode
+///
+/// \note
+/// The notice type is identified by the default identifier returned by
+/// UnfNotice::StageNoticeImpl::GetTypeId.
+template <class T>
+void NoticeSerializationDefine()
+{
+    NoticeSerializer::Register(
+        PXR_NS::ArchGetDemangled(typeid(T).name()), [](NoticeReader& reader) {
+            return UnfNotice::StageNoticeRefPtr(T::Deserialize(reader));
+        });
+}
+
+}  // namespace unf
+
+#endif  // USD_NOTICE_FRAMEWORK_SERIALIZATION_H
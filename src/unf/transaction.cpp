@@ -2,41 +2,154 @@
 #include "unf/broker.h"
 #include "unf/capturePredicate.h"
 
+#include <pxr/base/tf/diagnostic.h>
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/usd/common.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace unf {
 
 NoticeTransaction::NoticeTransaction(
-    const BrokerPtr& broker, CapturePredicate predicate)
-    : _broker(broker)
+    const BrokerPtr& broker, CapturePredicate predicate, Mode mode)
+    : _broker(broker), _mode(mode)
 {
     _broker->BeginTransaction(predicate);
+    _OpenChangeBlock();
 }
 
 NoticeTransaction::NoticeTransaction(
-    const BrokerPtr& broker, const CapturePredicateFunc& predicate)
-    : _broker(broker)
+    const BrokerPtr& broker, const CapturePredicateFunc& predicate, Mode mode)
+    : _broker(broker), _mode(mode)
 {
     _broker->BeginTransaction(predicate);
+    _OpenChangeBlock();
 }
 
 NoticeTransaction::NoticeTransaction(
-    const UsdStageRefPtr& stage, CapturePredicate predicate)
-    : _broker(Broker::Create(stage))
+    const UsdStageRefPtr& stage, CapturePredicate predicate, Mode mode)
+    : _broker(Broker::Create(stage)), _mode(mode)
 {
     _broker->BeginTransaction(predicate);
+    _OpenChangeBlock();
 }
 
 NoticeTransaction::NoticeTransaction(
-    const PXR_NS::UsdStageRefPtr& stage, const CapturePredicateFunc& predicate)
-    : _broker(Broker::Create(stage))
+    const PXR_NS::UsdStageRefPtr& stage,
+    const CapturePredicateFunc& predicate,
+    Mode mode)
+    : _broker(Broker::Create(stage)), _mode(mode)
 {
     _broker->BeginTransaction(predicate);
+    _OpenChangeBlock();
+}
+
+NoticeTransaction::~NoticeTransaction()
+{
+    // Release the change block first, so that notices sent by USD for the
+    // coalesced edits are captured by the transaction. Nested change blocks
+    // are only released by the outermost one.
+    _changeBlock.reset();
+
+    _broker->EndTransaction();
+}
+
+void NoticeTransaction::_OpenChangeBlock()
+{
+    if (_mode == Mode::ChangeBlock) {
+        _changeBlock = std::make_unique<SdfChangeBlock>();
+    }
+}
+
+MultiNoticeTransaction::MultiNoticeTransaction(
+    const std::vector<BrokerPtr>& brokers, CapturePredicate predicate)
+{
+    for (const auto& broker : brokers) {
+        _AddBroker(broker);
+    }
+
+    for (auto& broker : _brokers) {
+        broker->BeginTransaction(predicate);
+    }
+}
+
+MultiNoticeTransaction::MultiNoticeTransaction(
+    const std::vector<BrokerPtr>& brokers,
+    const CapturePredicateFunc& predicate)
+{
+    for (const auto& broker : brokers) {
+        _AddBroker(broker);
+    }
+
+    for (auto& broker : _brokers) {
+        broker->BeginTransaction(predicate);
+    }
 }
 
-NoticeTransaction::~NoticeTransaction() { _broker->EndTransaction(); }
+MultiNoticeTransaction::MultiNoticeTransaction(
+    const std::vector<UsdStageRefPtr>& stages, CapturePredicate predicate)
+{
+    for (const auto& stage : stages) {
+        if (stage) _AddBroker(Broker::Create(stage));
+    }
+
+    for (auto& broker : _brokers) {
+        broker->BeginTransaction(predicate);
+    }
+}
+
+MultiNoticeTransaction::MultiNoticeTransaction(
+    const std::vector<UsdStageRefPtr>& stages,
+    const CapturePredicateFunc& predicate)
+{
+    for (const auto& stage : stages) {
+        if (stage) _AddBroker(Broker::Create(stage));
+    }
+
+    for (auto& broker : _brokers) {
+        broker->BeginTransaction(predicate);
+    }
+}
+
+MultiNoticeTransaction::~MultiNoticeTransaction()
+{
+    // Merge notices captured by each broker in parallel. Brokers are
+    // associated with different stages, so merging does not require any
+    // synchronization.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, _brokers.size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                if (_brokers[i]) _brokers[i]->_MergeTransaction();
+            }
+        });
+
+    // Emit all notices merged in one phase.
+    for (auto& broker : _brokers) {
+        if (broker) broker->_CloseTransaction();
+    }
+}
+
+void MultiNoticeTransaction::_AddBroker(const BrokerPtr& broker)
+{
+    if (!broker) {
+        TF_CODING_ERROR("Invalid broker.");
+        return;
+    }
+
+    if (std::find(_brokers.begin(), _brokers.end(), broker)
+        != _brokers.end()) {
+        return;
+    }
+
+    _brokers.push_back(broker);
+}
 
 }  // namespace unf
@@ -8,8 +8,12 @@
 #include "unf/capturePredicate.h"
 
 #include <pxr/pxr.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/usd/common.h>
 
+#include <memory>
+#include <vector>
+
 namespace unf {
 
 /// \class NoticeTransaction
@@ -20,6 +24,34 @@ namespace unf {
 /// within a specific scope.
 class NoticeTransaction {
   public:
+    /// Indicate how edits are batched during the transaction.
+    enum class Mode {
+        /// Only defer emission of notices.
+        Default,
+
+        /// \brief
+        /// Also hold a PXR_NS::SdfChangeBlock for the scope of the
+        /// transaction.
+        ///
+        /// USD coalesces all edits into a single change list when the
+        /// change block is released, so that much fewer notices are
+        /// converted and captured by the transaction. The change block is
+        /// released before the transaction ends, so that the resulting
+        /// notices are consolidated with the others.
+        ///
+        /// Change blocks can be nested, and USD only sends notices when the
+        /// outermost one is released. Edits made within a nested transaction
+        /// are therefore filtered by the capture predicate of the transaction
+        /// holding the outermost change block.
+        ///
+        /// \warning
+        /// The stage is not recomposed before the end of the transaction, so
+        /// it must not be queried after being edited within the transaction.
+        /// The transaction must also be released on the thread which
+        /// created it.
+        ChangeBlock,
+    };
+
     /// \brief
     /// Create transaction from a Broker.
     ///
@@ -30,9 +62,12 @@ class NoticeTransaction {
     /// the entire scope of the transaction. A CapturePredicate can be passed to
     /// influence which notices are captured. Notices that are not captured
     /// will not be emitted.
+    ///
+    /// Use Mode::ChangeBlock to also batch edits within USD.
     UNF_API NoticeTransaction(
         const BrokerPtr &,
-        CapturePredicate predicate = CapturePredicate::Default());
+        CapturePredicate predicate = CapturePredicate::Default(),
+        Mode mode = Mode::Default);
 
     /// \brief
     /// Create transaction from a Broker with a capture predicate function.
@@ -45,7 +80,10 @@ class NoticeTransaction {
     ///     return (n.GetTypeId() != typeid(Foo).name());
     /// });
     /// \endcode
-    UNF_API NoticeTransaction(const BrokerPtr &, const CapturePredicateFunc &);
+    UNF_API NoticeTransaction(
+        const BrokerPtr &,
+        const CapturePredicateFunc &,
+        Mode mode = Mode::Default);
 
     /// \brief
     /// Create transaction from a UsdStage.
@@ -54,10 +92,11 @@ class NoticeTransaction {
     ///
     /// \sa
     /// NoticeTransaction(const BrokerPtr &, CapturePredicate predicate =
-    /// CapturePredicate::Default())
+    /// CapturePredicate::Default(), Mode mode = Mode::Default)
     UNF_API NoticeTransaction(
         const PXR_NS::UsdStageRefPtr &,
-        CapturePredicate predicate = CapturePredicate::Default());
+        CapturePredicate predicate = CapturePredicate::Default(),
+        Mode mode = Mode::Default);
 
     /// \brief
     /// Create transaction from a UsdStage with a capture predicate function.
@@ -65,10 +104,12 @@ class NoticeTransaction {
     /// Convenient constructor to encapsulate the creation of the broker.
     ///
     /// \sa
-    /// NoticeTransaction(const BrokerPtr &, const CapturePredicateFunc&)
-
+    /// NoticeTransaction(const BrokerPtr &, const CapturePredicateFunc&,
+    /// Mode mode = Mode::Default)
     UNF_API NoticeTransaction(
-        const PXR_NS::UsdStageRefPtr &, const CapturePredicateFunc &);
+        const PXR_NS::UsdStageRefPtr &,
+        const CapturePredicateFunc &,
+        Mode mode = Mode::Default);
 
     /// Delete object and end transaction.
     UNF_API virtual ~NoticeTransaction();
@@ -82,9 +123,101 @@ class NoticeTransaction {
     /// Return associated Broker instance.
     UNF_API BrokerPtr GetBroker() { return _broker; }
 
+    /// Return mode used by the transaction.
+    Mode GetMode() const { return _mode; }
+
   private:
+    /// Open change block if required by the mode.
+    void _OpenChangeBlock();
+
     /// Broker associated with transaction.
     BrokerPtr _broker;
+
+    /// Mode used by the transaction.
+    Mode _mode;
+
+    /// Change block held when Mode::ChangeBlock is used.
+    std::unique_ptr<PXR_NS::SdfChangeBlock> _changeBlock;
+};
+
+/// \class MultiNoticeTransaction
+///
+/// \brief
+/// Convenient [RAII](https://en.cppreference.com/w/cpp/language/raii) object
+/// to consolidate and filter notices derived from UnfNotice::StageNotice
+/// within a specific scope for several brokers at once.
+///
+/// A transaction is started on each broker. When the object is deleted, the
+/// notices captured by each broker are merged in parallel, and all notices
+/// are then emitted in one phase, following the order of the brokers.
+/// Listeners observing several stages therefore receive all notices after
+/// all stages have been edited.
+///
+/// \code{.cpp}
+/// {
+///     std::vector<unf::BrokerPtr> brokers = {broker1, broker2};
+///     unf::MultiNoticeTransaction transaction(brokers);
+///
+///     // Edit stages...
+/// }
+/// \endcode
+///
+/// \note
+/// Notices shared between brokers are merged concurrently, so a notice must
+/// only be sent via one of the brokers.
+class MultiNoticeTransaction {
+  public:
+    /// \brief
+    /// Create transaction from several brokers.
+    ///
+    /// Brokers listed several times are only used once. A CapturePredicate
+    /// can be passed to influence which notices are captured by each
+    /// broker.
+    UNF_API MultiNoticeTransaction(
+        const std::vector<BrokerPtr> &,
+        CapturePredicate predicate = CapturePredicate::Default());
+
+    /// Create transaction from several brokers with a capture predicate
+    /// function.
+    UNF_API MultiNoticeTransaction(
+        const std::vector<BrokerPtr> &, const CapturePredicateFunc &);
+
+    /// \brief
+    /// Create transaction from several UsdStages.
+    ///
+    /// Convenient constructor to encapsulate the creation of the brokers.
+    UNF_API MultiNoticeTransaction(
+        const std::vector<PXR_NS::UsdStageRefPtr> &,
+        CapturePredicate predicate = CapturePredicate::Default());
+
+    /// \brief
+    /// Create transaction from several UsdStages with a capture predicate
+    /// function.
+    ///
+    /// Convenient constructor to encapsulate the creation of the brokers.
+    UNF_API MultiNoticeTransaction(
+        const std::vector<PXR_NS::UsdStageRefPtr> &,
+        const CapturePredicateFunc &);
+
+    /// Delete object and end transaction on all brokers.
+    UNF_API virtual ~MultiNoticeTransaction();
+
+    /// Remove default copy constructor.
+    UNF_API MultiNoticeTransaction(const MultiNoticeTransaction &) = delete;
+
+    /// Remove default assignment operator.
+    UNF_API MultiNoticeTransaction &operator=(
+        const MultiNoticeTransaction &) = delete;
+
+    /// Return associated Broker instances.
+    const std::vector<BrokerPtr> &GetBrokers() const { return _brokers; }
+
+  private:
+    /// Record \p broker unless it is invalid or already recorded.
+    void _AddBroker(const BrokerPtr &broker);
+
+    /// Brokers associated with transaction.
+    std::vector<BrokerPtr> _brokers;
 };
 
 }  // namespace unf
@@ -1,6 +1,6 @@
 # -*- coding: utf-8 -*-
 
-from pxr import Usd
+from pxr import Usd, Tf, Sdf
 import unf
 
 
@@ -51,3 +51,171 @@ def test_broker_transaction_nested():
     broker.EndTransaction()
     assert broker.IsInTransaction() is False
 
+
+def test_broker_chunked_delivery():
+    """Deliver large ObjectsChanged notice in chunks."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    assert broker.GetChunkedDeliverySize() == 0
+
+    broker.SetChunkedDelivery(2)
+    assert broker.GetChunkedDeliverySize() == 2
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice.GetResyncedPaths())
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    for name in ["A", "B", "C", "D", "E"]:
+        stage.DefinePrim("/{}".format(name))
+    broker.EndTransaction()
+
+    # No notices are emitted until pumped.
+    assert len(received) == 0
+    assert broker.HasPendingNotices() is True
+
+    assert broker.PumpNotices() == 1
+    assert received == [[Sdf.Path("/A"), Sdf.Path("/B")]]
+
+    pumped = broker.PumpNoticesFor(10.0)
+    assert pumped >= 1
+    assert pumped + broker.FlushNotices() == 2
+    assert broker.HasPendingNotices() is False
+
+    assert received[1:] == [
+        [Sdf.Path("/C"), Sdf.Path("/D")], [Sdf.Path("/E")]
+    ]
+
+    broker.SetChunkedDelivery(0)
+
+def test_broker_lazy_registration():
+    """Only emit requested notices."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    assert broker.IsLazyRegistrationEnabled() is False
+    broker.SetLazyRegistration(True)
+    assert broker.IsLazyRegistrationEnabled() is True
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    stage.DefinePrim("/A")
+    assert len(received) == 0
+
+    assert broker.IsRequested(unf.Notice.ObjectsChanged) is False
+    broker.RequestNotices(unf.Notice.ObjectsChanged)
+    assert broker.IsRequested(Tf.Type.Find(unf.Notice.ObjectsChanged)) is True
+
+    stage.DefinePrim("/B")
+    assert len(received) == 1
+
+    broker.ReleaseNotices(unf.Notice.ObjectsChanged)
+
+    stage.DefinePrim("/C")
+    assert len(received) == 1
+
+    broker.SetLazyRegistration(False)
+
+
+def test_broker_subscribe():
+    """Subscribe to notices emitted by broker."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+    tf_received = []
+
+    def _record(notice):
+        """Record notice received."""
+        assert isinstance(notice, unf.Notice.ObjectsChanged)
+        received.append(notice)
+
+    def _record_tf(notice, stage):
+        """Record notice received via Tf.Notice."""
+        tf_received.append(notice)
+
+    subscription = broker.Subscribe(unf.Notice.ObjectsChanged, _record)
+    assert subscription.IsActive() is True
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _record_tf, stage)
+
+    stage.DefinePrim("/A")
+    assert len(received) == 1
+    assert len(tf_received) == 1
+
+    assert broker.IsTfNoticeDeliveryEnabled() is True
+    broker.SetTfNoticeDelivery(False)
+    assert broker.IsTfNoticeDeliveryEnabled() is False
+
+    stage.DefinePrim("/B")
+    assert len(received) == 2
+    assert len(tf_received) == 1
+
+    subscription.Reset()
+    assert subscription.IsActive() is False
+
+    stage.DefinePrim("/C")
+    assert len(received) == 2
+
+
+def test_broker_journal():
+    """Poll changes recorded by the journal."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    broker.SetJournalCapacity(10)
+    assert broker.GetJournalCapacity() == 10
+
+    cursor = unf.JournalCursor(broker)
+    assert cursor.HasChanges() is False
+
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+
+    assert cursor.HasChanges() is True
+
+    changes = cursor.Fetch()
+    assert changes.sequence == broker.GetJournalSequence()
+    assert changes.resyncAll is False
+    assert isinstance(changes.notice, unf.Notice.TransactionCommitted)
+
+    notices = [
+        notice for notice in changes.notice.GetNotices()
+        if isinstance(notice, unf.Notice.ObjectsChanged)
+    ]
+    assert len(notices) == 1
+    assert sorted(notices[0].GetResyncedPaths()) == ["/Bar", "/Foo"]
+
+    assert cursor.HasChanges() is False
+    assert cursor.Fetch().notice is None
+
+
+def test_broker_journal_overflow():
+    """Ensure that dropped emissions are reported."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    broker.SetJournalCapacity(1)
+
+    cursor = unf.JournalCursor(broker, 0)
+
+    with unf.NoticeTransaction(broker):
+        stage.DefinePrim("/Foo")
+
+    with unf.NoticeTransaction(broker):
+        stage.DefinePrim("/Bar")
+
+    changes = cursor.Fetch()
+    assert changes.resyncAll is True
+    assert changes.sequence == broker.GetJournalSequence()
+
+    changes = broker.GetJournalChanges(changes.sequence - 1)
+    assert changes.resyncAll is False
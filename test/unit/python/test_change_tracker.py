@@ -0,0 +1,41 @@
+# -*- coding: utf-8 -*-
+
+from pxr import Usd, Sdf
+import unf
+
+
+def test_change_tracker():
+    """Query paths changed since a generation."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    tracker = unf.ChangeTracker(broker)
+    assert tracker.GetGeneration() == 0
+
+    stage.DefinePrim("/Foo")
+    generation = tracker.GetGeneration()
+    assert generation == 1
+
+    stage.DefinePrim("/Bar")
+    assert tracker.GetGeneration() == 2
+
+    assert tracker.ChangedSince(Sdf.Path("/Foo"), 0) is True
+    assert tracker.ChangedSince(Sdf.Path("/Foo/Child"), 0) is True
+    assert tracker.ChangedSince(Sdf.Path("/Foo"), generation) is False
+    assert tracker.ChangedSince(Sdf.Path("/Bar"), generation) is True
+
+
+def test_change_tracker_compact():
+    """Discard stamps older than a generation."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    tracker = unf.ChangeTracker(broker)
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Bar")
+
+    tracker.Compact(1)
+
+    assert tracker.ChangedSince(Sdf.Path("/Foo"), 1) is False
+    assert tracker.ChangedSince(Sdf.Path("/Bar"), 1) is True
+    assert tracker.ChangedSince(Sdf.Path("/Other"), 0) is True
@@ -0,0 +1,50 @@
+# -*- coding: utf-8 -*-
+
+from pxr import Usd, Sdf, Tf
+import unf
+
+
+def _create_layer(value):
+    """Create anonymous layer with one attribute."""
+    layer = Sdf.Layer.CreateAnonymous(".usda")
+    layer.ImportFromString(
+        "#usda 1.0\n"
+        "def Xform \"A\" {{\n"
+        "    double value = {}\n"
+        "}}\n".format(value)
+    )
+    return layer
+
+
+def test_layer_diff():
+    """Compare two layers."""
+    diff = unf.LayerDiff(_create_layer(1), _create_layer(1))
+    assert diff.IsEmpty() is True
+
+    diff = unf.LayerDiff(_create_layer(1), _create_layer(2))
+    assert diff.IsEmpty() is False
+    assert diff.GetResyncedPaths() == []
+    assert diff.GetChangedInfoOnlyPaths() == [Sdf.Path("/A.value")]
+
+
+def test_replace_layer_content():
+    """Replace layer content and receive fine-grained notice."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    layer = stage.GetRootLayer()
+    layer.TransferContent(_create_layer(1))
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    unf.ReplaceLayerContent(broker, layer, _create_layer(2))
+
+    assert len(received) == 1
+    assert received[0].GetResyncedPaths() == []
+    assert received[0].GetChangedInfoOnlyPaths() == ["/A.value"]
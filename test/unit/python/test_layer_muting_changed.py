@@ -82,3 +82,70 @@ def test_layer_muting_changed_get_unmuted_layers():
     # Ensure that one notice was received.
     assert len(received) == 1
 
+
+
+def test_layer_muting_changed_get_affected_prim_paths():
+    """Ensure that prims composed with muted layers are returned."""
+    stage = Usd.Stage.CreateInMemory()
+    unf.Broker.Create(stage)
+
+    root_layer = stage.GetRootLayer()
+    layer1 = Sdf.Layer.CreateAnonymous(".usda")
+    layer2 = Sdf.Layer.CreateAnonymous(".usda")
+    root_layer.subLayerPaths.append(layer1.identifier)
+    root_layer.subLayerPaths.append(layer2.identifier)
+
+    Sdf.CreatePrimInLayer(layer1, "/Foo/Bar")
+    Sdf.CreatePrimInLayer(layer2, "/Baz")
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Baz")
+    stage.DefinePrim("/Other")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetAffectedPrimPaths() == ["/Foo", "/Foo/Bar"]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.LayerMutingChanged, _validate, stage)
+
+    stage.MuteLayer(layer1.identifier)
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+
+def test_layer_muting_changed_get_affected_prim_paths_merged():
+    """Ensure that prims affected are computed on merged notice."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    root_layer = stage.GetRootLayer()
+    layer1 = Sdf.Layer.CreateAnonymous(".usda")
+    layer2 = Sdf.Layer.CreateAnonymous(".usda")
+    root_layer.subLayerPaths.append(layer1.identifier)
+    root_layer.subLayerPaths.append(layer2.identifier)
+
+    Sdf.CreatePrimInLayer(layer1, "/Foo")
+    Sdf.CreatePrimInLayer(layer2, "/Bar")
+    stage.DefinePrim("/Foo")
+    stage.DefinePrim("/Other")
+
+    stage.MuteLayer(layer2.identifier)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetAffectedPrimPaths() == ["/Bar", "/Foo"]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.LayerMutingChanged, _validate, stage)
+
+    with unf.NoticeTransaction(broker):
+        stage.MuteLayer(layer1.identifier)
+        stage.UnmuteLayer(layer2.identifier)
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
@@ -3,6 +3,8 @@
 from pxr import Usd, Tf, Sdf
 import unf
 
+import pytest
+
 
 def test_objects_changed():
     """Test whether ObjectsChanged notice is as expected."""
@@ -16,6 +18,7 @@ def test_objects_changed():
     def _validate(notice, stage):
         """Validate notice received."""
         assert notice.IsMergeable() is True
+        assert notice.GetMergePolicy().GetMode() == unf.MergePolicy.Mode.Merge
         assert notice.GetTypeId() == "unf::UnfNotice::ObjectsChanged"
         received.append(notice)
 
@@ -164,3 +167,218 @@ def test_objects_changed_has_changed_fields():
 
     # Ensure that one notice was received.
     assert len(received) == 1
+
+def test_objects_changed_derived_views():
+    """Check derived views computed from notice."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    prim1 = stage.DefinePrim("/Foo", "Cylinder")
+    prim1.GetAttribute("radius").Set(1.0)
+    prim2 = stage.DefinePrim("/Bar")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetResyncedPrimPaths() == [Sdf.Path("/Baz")]
+        assert notice.GetChangedPropertiesByPrim() == {
+            Sdf.Path("/Foo"): [Sdf.Path("/Foo.radius")]
+        }
+        assert notice.GetValueChangedPrimPaths() == [Sdf.Path("/Foo")]
+        assert notice.GetMetadataChangedPrimPaths() == [Sdf.Path("/Bar")]
+        assert notice.GetAffectedPrimPaths() == [
+            Sdf.Path("/Bar"), Sdf.Path("/Baz"), Sdf.Path("/Foo")
+        ]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    prim1.GetAttribute("radius").Set(5.0)
+    prim2.SetMetadata("comment", "This is a test")
+    stage.DefinePrim("/Baz")
+    stage.DefinePrim("/Baz/Child")
+    broker.EndTransaction()
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+def test_objects_changed_sequence_views():
+    """Check sequence views returned by notice."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    prim = stage.DefinePrim("/Foo")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        paths = notice.GetResyncedPaths()
+        assert len(paths) == 2
+        assert paths[0] == Sdf.Path("/A")
+        assert paths[-1] == Sdf.Path("/B")
+        assert Sdf.Path("/A") in paths
+        assert Sdf.Path("/Foo") not in paths
+        assert list(paths) == [Sdf.Path("/A"), Sdf.Path("/B")]
+        assert paths == [Sdf.Path("/A"), Sdf.Path("/B")]
+
+        with pytest.raises(IndexError):
+            paths[2]
+
+        fields = notice.GetChangedFields(Sdf.Path("/Foo"))
+        assert len(fields) == 1
+        assert "comment" in fields
+        assert list(fields) == ["comment"]
+        assert fields == {"comment"}
+
+        # Field names are not ordered, so they cannot be indexed.
+        with pytest.raises(TypeError):
+            fields[0]
+
+        assert len(notice.GetChangedFields(Sdf.Path("/Incorrect"))) == 0
+        received.append(notice.GetChangedInfoOnlyPaths())
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/A")
+    stage.DefinePrim("/B")
+    prim.SetMetadata("comment", "This is a test")
+    broker.EndTransaction()
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+    # Views keep the notice alive.
+    assert received[0] == [Sdf.Path("/Foo")]
+
+
+def test_objects_changed_bulk_queries():
+    """Query many paths at once."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    prim = stage.DefinePrim("/Foo")
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        paths = [
+            Sdf.Path("/A"), Sdf.Path("/A/B"), Sdf.Path("/Foo"),
+            Sdf.Path("/Foo.attr"), Sdf.Path("/Incorrect")
+        ]
+        assert notice.QueryResynced(paths) == [
+            True, True, False, False, False
+        ]
+        assert notice.QueryChangedInfoOnly(paths) == [
+            False, False, True, True, False
+        ]
+        assert notice.QueryAffected(paths) == [
+            True, True, True, True, False
+        ]
+        assert notice.QueryHasChangedFields(paths) == [
+            True, False, True, False, False
+        ]
+        assert notice.QueryChangeCategories(paths) == [
+            unf.ChangeCategory.Structure,
+            unf.ChangeCategory.Structure,
+            unf.ChangeCategory.Metadata,
+            unf.ChangeCategory.Metadata,
+            0,
+        ]
+
+        # Paths do not need to be sorted.
+        assert notice.QueryAffected(list(reversed(paths))) == [
+            False, True, True, True, True
+        ]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/A")
+    prim.SetMetadata("comment", "This is a test")
+    broker.EndTransaction()
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+
+def test_objects_changed_change_categories():
+    """Classify changes per category."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    prim = stage.DefinePrim("/Foo")
+    attribute = prim.CreateAttribute("attr", Sdf.ValueTypeNames.Int)
+    attribute.Set(1)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        categories = notice.GetChangeCategories()
+        assert categories & unf.ChangeCategory.TimeSamples
+        assert categories & unf.ChangeCategory.Metadata
+        assert categories & unf.ChangeCategory.Structure
+        assert not categories & unf.ChangeCategory.Value
+
+        assert notice.GetChangeCategories(Sdf.Path("/Foo.attr")) == (
+            unf.ChangeCategory.TimeSamples
+        )
+        assert notice.GetChangeCategories(Sdf.Path("/Foo")) == (
+            unf.ChangeCategory.Metadata
+        )
+        assert notice.GetChangeCategories(Sdf.Path("/A")) == (
+            unf.ChangeCategory.Structure
+        )
+        assert notice.GetChangeCategories(Sdf.Path("/Incorrect")) == 0
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    broker.BeginTransaction()
+    attribute.Set(2, 1.0)
+    prim.SetMetadata("comment", "This is a test")
+    stage.DefinePrim("/A")
+    broker.EndTransaction()
+
+    # Ensure that one notice was received.
+    assert len(received) == 1
+
+
+def test_objects_changed_coarsened():
+    """Coarsen notice when transaction ends."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    stage.DefinePrim("/World")
+
+    policy = unf.CoarseningPolicy()
+    assert policy.IsEnabled() is False
+
+    policy.maxChildren = 2
+    assert policy.IsEnabled() is True
+
+    broker.SetCoarseningPolicy(policy)
+    assert broker.GetCoarseningPolicy().maxChildren == 2
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    with unf.NoticeTransaction(broker):
+        for name in ["A", "B", "C"]:
+            stage.DefinePrim("/World/{}".format(name))
+
+    assert len(received) == 1
+    assert received[0].IsCoarsened() is True
+    assert received[0].GetResyncedPaths() == [Sdf.Path("/World")]
+
+    broker.SetCoarseningPolicy(unf.CoarseningPolicy())
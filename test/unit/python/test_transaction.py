@@ -3,6 +3,8 @@
 from pxr import Usd, Tf
 import unf
 
+import pytest
+
 
 def test_transaction_create_from_broker():
     """Create a transaction from broker."""
@@ -303,3 +305,229 @@ def test_transaction_nested_with_filter():
 
     # Ensure that one notice was received.
     assert len(received) == 1
+
+def test_transaction_with_python_thread():
+    """Close transaction while another Python thread is running."""
+    import threading
+
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+    stop = threading.Event()
+    counter = []
+
+    def _run():
+        """Keep using the interpreter while transactions are closed."""
+        while not stop.is_set():
+            counter.append(1)
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    def _filter(notice):
+        """Keep all notices."""
+        return True
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    thread = threading.Thread(target=_run)
+    thread.start()
+
+    for index in range(20):
+        with unf.NoticeTransaction(broker, predicate=_filter):
+            stage.DefinePrim("/Foo{}".format(index))
+
+    broker.BeginTransaction()
+    stage.DefinePrim("/Bar")
+    broker.EndTransaction()
+
+    stop.set()
+    thread.join()
+
+    # Ensure that one notice was received per transaction.
+    assert len(received) == 21
+    assert len(counter) > 0
+
+def test_transaction_with_block_types_predicate():
+    """Create a transaction which blocks notice types."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        received.append(notice)
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+    key2 = Tf.Notice.Register(
+        unf.Notice.StageContentsChanged, _validate, stage
+    )
+
+    predicate = unf.CapturePredicate.BlockTypes([unf.Notice.ObjectsChanged])
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Foo")
+
+    assert len(received) == 1
+    assert isinstance(received[0], unf.Notice.StageContentsChanged)
+
+    del received[:]
+
+    predicate = unf.CapturePredicate.AllowTypes(
+        [Tf.Type.Find(unf.Notice.ObjectsChanged)]
+    )
+
+    with unf.NoticeTransaction(broker, predicate=predicate):
+        stage.DefinePrim("/Bar")
+
+    assert len(received) == 1
+    assert isinstance(received[0], unf.Notice.ObjectsChanged)
+
+def test_transaction_commit_composite():
+    """Receive all notices from transaction within one notice."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+    broker.SetCommitDelivery(unf.Broker.CommitDelivery.Composite)
+
+    assert broker.GetCommitDelivery() == unf.Broker.CommitDelivery.Composite
+
+    received = []
+    batches = []
+
+    def _record(notice, stage):
+        """Record notice received."""
+        received.append(notice)
+
+    def _record_batch(notice, stage):
+        """Record composite notice received."""
+        batches.append(notice.GetNotices())
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _record, stage)
+    key2 = Tf.Notice.Register(
+        unf.Notice.TransactionCommitted, _record_batch, stage
+    )
+
+    with unf.NoticeTransaction(broker):
+        stage.DefinePrim("/Foo")
+        stage.DefinePrim("/Bar")
+
+    assert len(received) == 0
+    assert len(batches) == 1
+
+    notices = [
+        notice for notice in batches[0]
+        if isinstance(notice, unf.Notice.ObjectsChanged)
+    ]
+    assert len(notices) == 1
+    assert sorted(notices[0].GetResyncedPaths()) == ["/Bar", "/Foo"]
+
+
+def test_transaction_change_block():
+    """Create a transaction which also holds a change block."""
+    stage = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage)
+
+    foo = stage.DefinePrim("/Foo")
+    bar = stage.DefinePrim("/Bar")
+
+    captured = []
+
+    def _predicate(notice):
+        """Record notices captured."""
+        if isinstance(notice, unf.Notice.ObjectsChanged):
+            captured.append(notice)
+        return True
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetChangedInfoOnlyPaths() == ["/Bar", "/Foo"]
+        received.append(notice)
+
+    key = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage)
+
+    mode = unf.NoticeTransaction.Mode.ChangeBlock
+
+    with unf.NoticeTransaction(broker, _predicate, mode=mode):
+        foo.SetMetadata("comment", "A")
+        foo.SetMetadata("documentation", "B")
+        bar.SetMetadata("comment", "C")
+
+        # USD does not send notices until the change block is released.
+        assert len(captured) == 0
+
+    # Ensure that edits were coalesced by USD into one notice.
+    assert len(captured) == 1
+    assert len(received) == 1
+
+
+def test_multi_transaction_from_stages():
+    """Create a transaction for several stages."""
+    stage1 = Usd.Stage.CreateInMemory()
+    stage2 = Usd.Stage.CreateInMemory()
+
+    received = []
+
+    def _validate(notice, stage):
+        """Validate notice received."""
+        assert notice.GetResyncedPaths() == ["/Bar", "/Foo"]
+        received.append(stage)
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage1)
+    key2 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _validate, stage2)
+
+    with unf.MultiNoticeTransaction([stage1, stage2]) as transaction:
+        brokers = transaction.GetBrokers()
+        assert len(brokers) == 2
+        assert brokers[0].GetStage() == stage1
+        assert brokers[1].GetStage() == stage2
+        assert brokers[0].IsInTransaction() is True
+        assert brokers[1].IsInTransaction() is True
+
+        stage1.DefinePrim("/Foo")
+        stage2.DefinePrim("/Foo")
+        stage1.DefinePrim("/Bar")
+        stage2.DefinePrim("/Bar")
+
+        assert len(received) == 0
+
+    # Ensure that one notice was received per stage.
+    assert received == [stage1, stage2]
+
+
+def test_multi_transaction_with_filter():
+    """Create a transaction for several brokers with a predicate."""
+    stage1 = Usd.Stage.CreateInMemory()
+    stage2 = Usd.Stage.CreateInMemory()
+    broker = unf.Broker.Create(stage2)
+
+    received = []
+
+    def _record(notice, stage):
+        """Record notice received."""
+        received.append(notice)
+
+    key1 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _record, stage1)
+    key2 = Tf.Notice.Register(unf.Notice.ObjectsChanged, _record, stage2)
+
+    def _predicate(notice):
+        """Block ObjectsChanged notices."""
+        return not isinstance(notice, unf.Notice.ObjectsChanged)
+
+    with unf.MultiNoticeTransaction([stage1, broker], _predicate):
+        stage1.DefinePrim("/Foo")
+        stage2.DefinePrim("/Foo")
+
+    assert len(received) == 0
+
+
+def test_multi_transaction_invalid_target():
+    """Fail to create a transaction from invalid targets."""
+    stage = Usd.Stage.CreateInMemory()
+
+    with pytest.raises(TypeError):
+        unf.MultiNoticeTransaction([stage, "incorrect"])
@@ -0,0 +1,154 @@
+#include <unf/broker.h>
+#include <unf/changeTracker.h>
+#include <unf/transaction.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/valueTypeName.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+class ChangeTrackerTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+};
+
+TEST_F(ChangeTrackerTest, Resync)
+{
+    unf::ChangeTracker tracker(_broker);
+    ASSERT_EQ(tracker.GetGeneration(), 0);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(tracker.GetGeneration(), 1);
+
+    const uint64_t generation = tracker.GetGeneration();
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/Bar/Baz"});
+    ASSERT_EQ(tracker.GetGeneration(), 2);
+
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, 0));
+    ASSERT_FALSE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, generation));
+
+    // Resyncs are inherited by descendants.
+    ASSERT_TRUE(
+        tracker.ChangedSince(PXR_NS::SdfPath{"/Foo/Bar"}, generation));
+    ASSERT_TRUE(
+        tracker.ChangedSince(PXR_NS::SdfPath{"/Foo/Bar/Baz/Qux"}, generation));
+
+    ASSERT_FALSE(tracker.ChangedSince(PXR_NS::SdfPath{"/Other"}, 0));
+
+    // Nothing changed since the current generation.
+    ASSERT_FALSE(tracker.ChangedSince(
+        PXR_NS::SdfPath{"/Foo/Bar"}, tracker.GetGeneration()));
+}
+
+TEST_F(ChangeTrackerTest, ChangedInfo)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto attribute = prim.CreateAttribute(
+        PXR_NS::TfToken{"attr"}, PXR_NS::SdfValueTypeNames->Int);
+
+    unf::ChangeTracker tracker(_broker);
+
+    attribute.Set(1);
+    ASSERT_EQ(tracker.GetGeneration(), 1);
+
+    // Owning prim is modified with its property.
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo.attr"}, 0));
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, 0));
+
+    // Modifications are not inherited by descendants.
+    ASSERT_FALSE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo/Bar"}, 0));
+    ASSERT_FALSE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo.other"}, 0));
+}
+
+TEST_F(ChangeTrackerTest, ResyncDiscardsDescendants)
+{
+    unf::ChangeTracker tracker(_broker);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/A"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/B"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo/C"});
+
+    const size_t size = tracker.GetSize();
+
+    _stage->RemovePrim(PXR_NS::SdfPath{"/Foo"});
+
+    // Stamps of /Foo/A, /Foo/B and /Foo/C are superseded by /Foo.
+    ASSERT_LT(tracker.GetSize(), size);
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo/A"}, 3));
+}
+
+TEST_F(ChangeTrackerTest, Transaction)
+{
+    unf::ChangeTracker tracker(_broker);
+
+    {
+        unf::NoticeTransaction transaction(_broker);
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+        ASSERT_EQ(tracker.GetGeneration(), 0);
+    }
+
+    // Consolidated notice increments the generation once.
+    ASSERT_EQ(tracker.GetGeneration(), 1);
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, 0));
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Bar"}, 0));
+}
+
+TEST_F(ChangeTrackerTest, CompositeDelivery)
+{
+    _broker->SetCommitDelivery(unf::Broker::CommitDelivery::Composite);
+
+    unf::ChangeTracker tracker(_broker);
+
+    {
+        unf::NoticeTransaction transaction(_broker);
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    }
+
+    ASSERT_EQ(tracker.GetGeneration(), 1);
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, 0));
+}
+
+TEST_F(ChangeTrackerTest, Compact)
+{
+    unf::ChangeTracker tracker(_broker);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    tracker.Compact(1);
+
+    // Stamps more recent than the generation compacted are preserved.
+    ASSERT_FALSE(tracker.ChangedSince(PXR_NS::SdfPath{"/Foo"}, 1));
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Bar"}, 1));
+
+    // Older generations report all paths as changed.
+    ASSERT_TRUE(tracker.ChangedSince(PXR_NS::SdfPath{"/Other"}, 0));
+}
+
+TEST_F(ChangeTrackerTest, Stop)
+{
+    {
+        unf::ChangeTracker tracker(_broker);
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        ASSERT_EQ(tracker.GetGeneration(), 1);
+    }
+
+    // Callback is unregistered when the tracker is destroyed.
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+}
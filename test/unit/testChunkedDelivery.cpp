@@ -0,0 +1,145 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+
+#include <unfTest/notice.h>
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <chrono>
+#include <string>
+
+class ChunkedDeliveryTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    void _DefinePrims(size_t count)
+    {
+        _broker->BeginTransaction();
+        for (size_t i = 0; i < count; ++i) {
+            const auto name = "/Prim" + std::to_string(_index++);
+            _stage->DefinePrim(PXR_NS::SdfPath{name});
+        }
+        _broker->EndTransaction();
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    size_t _index = 0;
+};
+
+TEST_F(ChunkedDeliveryTest, Disabled)
+{
+    ASSERT_EQ(_broker->GetChunkedDeliverySize(), 0);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _DefinePrims(10);
+
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_FALSE(_broker->HasPendingNotices());
+}
+
+TEST_F(ChunkedDeliveryTest, Pump)
+{
+    _broker->SetChunkedDelivery(3);
+    ASSERT_EQ(_broker->GetChunkedDeliverySize(), 3);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _DefinePrims(10);
+
+    // Chunks are held until pumped.
+    ASSERT_EQ(observer.Received(), 0);
+    ASSERT_TRUE(_broker->HasPendingNotices());
+
+    ASSERT_EQ(_broker->PumpNotices(), 1);
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_EQ(observer.GetLatestNotice().GetResyncedPaths().size(), 3);
+
+    ASSERT_EQ(_broker->PumpNotices(2), 2);
+    ASSERT_EQ(observer.Received(), 3);
+
+    ASSERT_EQ(_broker->PumpNotices(10), 1);
+    ASSERT_EQ(observer.Received(), 4);
+    ASSERT_EQ(observer.GetLatestNotice().GetResyncedPaths().size(), 1);
+
+    ASSERT_FALSE(_broker->HasPendingNotices());
+    ASSERT_EQ(_broker->PumpNotices(), 0);
+}
+
+TEST_F(ChunkedDeliveryTest, SmallNotice)
+{
+    _broker->SetChunkedDelivery(3);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _DefinePrims(2);
+
+    // Notice is delivered immediately when no chunks are pending.
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_FALSE(_broker->HasPendingNotices());
+
+    _DefinePrims(5);
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Notice is held when chunks are pending to preserve order.
+    _DefinePrims(1);
+    ASSERT_EQ(observer.Received(), 1);
+
+    ASSERT_EQ(_broker->FlushNotices(), 3);
+    ASSERT_EQ(observer.Received(), 4);
+}
+
+TEST_F(ChunkedDeliveryTest, OtherNotices)
+{
+    _broker->SetChunkedDelivery(3);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(_stage);
+
+    _DefinePrims(10);
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(observer.Received(), 1);
+}
+
+TEST_F(ChunkedDeliveryTest, PumpFor)
+{
+    _broker->SetChunkedDelivery(1);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _DefinePrims(10);
+
+    // At least one chunk is delivered.
+    const size_t emitted =
+        _broker->PumpNoticesFor(std::chrono::microseconds(0));
+    ASSERT_EQ(emitted, 1);
+    ASSERT_EQ(observer.Received(), 1);
+
+    ASSERT_EQ(_broker->PumpNoticesFor(std::chrono::seconds(10)), 9);
+    ASSERT_EQ(observer.Received(), 10);
+}
+
+TEST_F(ChunkedDeliveryTest, Disable)
+{
+    _broker->SetChunkedDelivery(3);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _DefinePrims(10);
+    ASSERT_EQ(observer.Received(), 0);
+
+    // Pending chunks are emitted when chunked delivery is disabled.
+    _broker->SetChunkedDelivery(0);
+    ASSERT_EQ(observer.Received(), 4);
+    ASSERT_FALSE(_broker->HasPendingNotices());
+}
@@ -0,0 +1,104 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+
+#include <unfTest/notice.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class ConcurrentDeliveryTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+};
+
+TEST_F(ConcurrentDeliveryTest, Default)
+{
+    ASSERT_FALSE(_broker->IsConcurrentDeliveryEnabled());
+
+    size_t received = 0;
+    _broker->AddConcurrentListener<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) { received++; });
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+
+    _broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(received, 1);
+
+    _broker->BeginTransaction();
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+
+    _broker->EndTransaction();
+    ASSERT_EQ(received, 2);
+}
+
+TEST_F(ConcurrentDeliveryTest, BaseType)
+{
+    size_t received = 0;
+    _broker->AddConcurrentListener<unf::UnfNotice::StageNotice>(
+        [&](const unf::UnfNotice::StageNotice&) { received++; });
+
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(received, 2);
+}
+
+TEST_F(ConcurrentDeliveryTest, Remove)
+{
+    size_t received = 0;
+    const size_t key = _broker->AddConcurrentListener<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) { received++; });
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+
+    _broker->RemoveConcurrentListener(key);
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+}
+
+TEST_F(ConcurrentDeliveryTest, Parallel)
+{
+    _broker->SetConcurrentDelivery(true);
+    ASSERT_TRUE(_broker->IsConcurrentDeliveryEnabled());
+
+    std::atomic<size_t> received{0};
+    std::atomic<size_t> running{0};
+
+    for (int i = 0; i < 4; ++i) {
+        _broker->AddConcurrentListener<::Test::MergeableNotice>(
+            [&](const ::Test::MergeableNotice& notice) {
+                running++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+                EXPECT_EQ(notice.GetData().size(), 2);
+                received++;
+                running--;
+            });
+    }
+
+    _broker->BeginTransaction();
+    _broker->Send<::Test::MergeableNotice>(::Test::DataMap{{"Foo", "Test1"}});
+    _broker->Send<::Test::MergeableNotice>(::Test::DataMap{{"Bar", "Test2"}});
+    _broker->EndTransaction();
+
+    // All listeners returned before the end of the transaction.
+    ASSERT_EQ(received, 4);
+    ASSERT_EQ(running, 0);
+}
@@ -45,3 +45,20 @@ TEST_F(DispatcherTest, Discover)
     ASSERT_EQ(_listener.Received<::Test::OutputNotice1>(), 1);
     ASSERT_EQ(_listener.Received<::Test::OutputNotice2>(), 1);
 }
+
+TEST_F(DispatcherTest, DiscoverMultiple)
+{
+    auto broker1 = unf::Broker::Create(_stage);
+
+    // Ensure that cached plugin types are used by following brokers.
+    auto stage2 = PXR_NS::UsdStage::CreateInMemory();
+    auto broker2 = unf::Broker::Create(stage2);
+
+    auto dispatcher = broker2->GetDispatcher("StageDispatcher");
+    ASSERT_TRUE(PXR_NS::TfDynamic_cast<NewStageDispatcherPtr>(dispatcher));
+    ASSERT_TRUE(PXR_NS::TfDynamic_cast<TestDispatcherPtr>(
+        broker2->GetDispatcher("NewDispatcher")));
+
+    // Each broker has its own dispatchers.
+    ASSERT_NE(dispatcher, broker1->GetDispatcher("StageDispatcher"));
+}
@@ -0,0 +1,192 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+#include <unf/transaction.h>
+
+#include <unfTest/notice.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+class JournalTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+};
+
+TEST_F(JournalTest, DisabledByDefault)
+{
+    ASSERT_EQ(_broker->GetJournalCapacity(), 0);
+    ASSERT_EQ(_broker->GetJournalSequence(), 0);
+
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::MergeableNotice>();
+
+    // Emissions are numbered even if they are not recorded.
+    ASSERT_EQ(_broker->GetJournalSequence(), 2);
+
+    const auto changes = _broker->GetJournalChanges(0);
+    ASSERT_EQ(changes.sequence, 2);
+    ASSERT_TRUE(changes.resyncAll);
+    ASSERT_FALSE(changes.notice);
+}
+
+TEST_F(JournalTest, GetChanges)
+{
+    _broker->SetJournalCapacity(10);
+
+    _broker->Send<::Test::MergeableNotice>(::Test::DataMap{{"Foo", "A"}});
+    _broker->Send<::Test::UnMergeableNotice>();
+    _broker->Send<::Test::MergeableNotice>(::Test::DataMap{{"Bar", "B"}});
+
+    ASSERT_EQ(_broker->GetJournalSequence(), 3);
+
+    const auto changes = _broker->GetJournalChanges(0);
+    ASSERT_EQ(changes.sequence, 3);
+    ASSERT_FALSE(changes.resyncAll);
+    ASSERT_TRUE(changes.notice);
+
+    // Notices are consolidated per type in the order of their first
+    // emission.
+    const auto& notices = changes.notice->GetNotices();
+    ASSERT_EQ(notices.size(), 2);
+
+    using MergeableNoticePtr = PXR_NS::TfRefPtr<::Test::MergeableNotice>;
+    auto notice = PXR_NS::TfDynamic_cast<MergeableNoticePtr>(notices[0]);
+    ASSERT_TRUE(notice);
+    ASSERT_EQ(
+        notice->GetData(), ::Test::DataMap({{"Foo", "A"}, {"Bar", "B"}}));
+    ASSERT_EQ(notices[1]->GetTypeId(), "Test::UnMergeableNotice");
+
+    // Only changes after the sequence requested are returned.
+    const auto _changes = _broker->GetJournalChanges(2);
+    ASSERT_EQ(_changes.sequence, 3);
+    ASSERT_FALSE(_changes.resyncAll);
+    ASSERT_EQ(_changes.notice->GetNotices().size(), 1);
+
+    // No changes after the latest sequence.
+    ASSERT_FALSE(_broker->GetJournalChanges(3).notice);
+}
+
+TEST_F(JournalTest, Transaction)
+{
+    _broker->SetJournalCapacity(10);
+
+    {
+        unf::NoticeTransaction transaction(_broker);
+
+        _broker->Send<::Test::MergeableNotice>();
+        _broker->Send<::Test::UnMergeableNotice>();
+        _broker->Send<::Test::UnMergeableNotice>();
+
+        ASSERT_EQ(_broker->GetJournalSequence(), 0);
+    }
+
+    // All notices consolidated by a transaction are a single emission.
+    ASSERT_EQ(_broker->GetJournalSequence(), 1);
+
+    const auto changes = _broker->GetJournalChanges(0);
+    ASSERT_EQ(changes.notice->GetNotices().size(), 3);
+}
+
+TEST_F(JournalTest, Overflow)
+{
+    _broker->SetJournalCapacity(2);
+
+    _broker->Send<::Test::UnMergeableNotice>();
+    _broker->Send<::Test::UnMergeableNotice>();
+    _broker->Send<::Test::UnMergeableNotice>();
+
+    // First emission was dropped.
+    const auto changes = _broker->GetJournalChanges(0);
+    ASSERT_EQ(changes.sequence, 3);
+    ASSERT_TRUE(changes.resyncAll);
+    ASSERT_EQ(changes.notice->GetNotices().size(), 2);
+
+    const auto _changes = _broker->GetJournalChanges(1);
+    ASSERT_FALSE(_changes.resyncAll);
+    ASSERT_EQ(_changes.notice->GetNotices().size(), 2);
+
+    // Disabling the journal drops all emissions.
+    _broker->SetJournalCapacity(0);
+    ASSERT_TRUE(_broker->GetJournalChanges(2).resyncAll);
+}
+
+TEST_F(JournalTest, Cursor)
+{
+    _broker->SetJournalCapacity(10);
+
+    _broker->Send<::Test::MergeableNotice>();
+
+    // Cursor only fetches changes emitted after its creation.
+    unf::JournalCursor cursor(_broker);
+    ASSERT_EQ(cursor.GetSequence(), 1);
+    ASSERT_FALSE(cursor.HasChanges());
+
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_TRUE(cursor.HasChanges());
+
+    auto changes = cursor.Fetch();
+    ASSERT_EQ(changes.sequence, 3);
+    ASSERT_FALSE(changes.resyncAll);
+    ASSERT_EQ(changes.notice->GetNotices().size(), 1);
+
+    ASSERT_EQ(cursor.GetSequence(), 3);
+    ASSERT_FALSE(cursor.HasChanges());
+    ASSERT_FALSE(cursor.Fetch().notice);
+
+    // Late cursor fetches all changes recorded.
+    unf::JournalCursor lateCursor(_broker, 0);
+    ASSERT_TRUE(lateCursor.HasChanges());
+    ASSERT_EQ(lateCursor.Fetch().notice->GetNotices().size(), 1);
+}
+
+TEST_F(JournalTest, LazyRegistration)
+{
+    _broker->SetLazyRegistration(true);
+    ASSERT_FALSE(
+        _broker->IsRequested(
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+
+    // All notices are requested while the journal is enabled.
+    _broker->SetJournalCapacity(10);
+    ASSERT_TRUE(
+        _broker->IsRequested(
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+
+    _stage->DefinePrim(PXR_NS::SdfPath("/Foo"));
+
+    const auto changes = _broker->GetJournalChanges(0);
+    ASSERT_FALSE(changes.resyncAll);
+    ASSERT_TRUE(changes.notice);
+
+    bool found = false;
+    for (const auto& notice : changes.notice->GetNotices()) {
+        using ObjectsChangedPtr =
+            PXR_NS::TfRefPtr<unf::UnfNotice::ObjectsChanged>;
+        auto objectsChanged = PXR_NS::TfDynamic_cast<ObjectsChangedPtr>(notice);
+        if (objectsChanged) {
+            found = true;
+            ASSERT_EQ(
+                objectsChanged->GetResyncedPaths(),
+                PXR_NS::SdfPathVector({PXR_NS::SdfPath("/Foo")}));
+        }
+    }
+    ASSERT_TRUE(found);
+
+    _broker->SetJournalCapacity(0);
+    ASSERT_FALSE(
+        _broker->IsRequested(
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+}
@@ -0,0 +1,159 @@
+#include <unf/broker.h>
+#include <unf/layerDiff.h>
+#include <unf/notice.h>
+
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+// Create layer from content of prims.
+PXR_NS::SdfLayerRefPtr _CreateLayer(
+    double value = 1,
+    const std::string& extraPrims = "",
+    const std::string& composition = "",
+    const std::string& documentation = "")
+{
+    auto layer = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+    layer->ImportFromString(
+        "#usda 1.0\n"
+        "def Xform \"A\" (\n" + composition + ")\n{\n"
+        "    double value = " + std::to_string(value) + "\n"
+        "    def Xform \"B\" {}\n"
+        "}\n"
+        "def Xform \"C\" (\n"
+        "    variants = { string v = \"x\" }\n"
+        "    prepend variantSets = \"v\"\n"
+        ") {\n"
+        "    variantSet \"v\" = {\n"
+        "        \"x\" {\n"
+        "            def Xform \"D\" (doc = \"" + documentation + "\") {}\n"
+        "        }\n"
+        "    }\n"
+        "}\n" + extraPrims);
+    return layer;
+}
+
+}  // namespace
+
+TEST(LayerDiffTest, Identical)
+{
+    unf::LayerDiff diff(_CreateLayer(), _CreateLayer());
+    ASSERT_TRUE(diff.IsEmpty());
+    ASSERT_TRUE(diff.GetResyncedPaths().empty());
+    ASSERT_TRUE(diff.GetChangedInfoOnlyPaths().empty());
+}
+
+TEST(LayerDiffTest, ChangedValue)
+{
+    unf::LayerDiff diff(_CreateLayer(1), _CreateLayer(2));
+    ASSERT_TRUE(diff.GetResyncedPaths().empty());
+    ASSERT_EQ(
+        diff.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/A.value"}});
+
+    const auto& fieldMap = diff.GetChangedFieldMap();
+    const auto it = fieldMap.find(PXR_NS::SdfPath{"/A.value"});
+    ASSERT_NE(it, fieldMap.end());
+    ASSERT_EQ(it->second, unf::TfTokenSet{PXR_NS::TfToken{"default"}});
+}
+
+TEST(LayerDiffTest, AddedAndRemovedSpecs)
+{
+    auto layer1 = _CreateLayer(1, "def \"E\" {}\n");
+    auto layer2 = _CreateLayer(1, "def \"F\" {}\n");
+
+    unf::LayerDiff diff(layer1, layer2);
+    ASSERT_EQ(
+        diff.GetResyncedPaths(),
+        PXR_NS::SdfPathVector({PXR_NS::SdfPath{"/E"}, PXR_NS::SdfPath{"/F"}}));
+    ASSERT_TRUE(diff.GetChangedInfoOnlyPaths().empty());
+}
+
+TEST(LayerDiffTest, CompositionField)
+{
+    auto layer1 = _CreateLayer();
+    auto layer2 = _CreateLayer(1, "", "    prepend references = </C>\n");
+
+    unf::LayerDiff diff(layer1, layer2);
+    ASSERT_EQ(
+        diff.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/A"}});
+    ASSERT_TRUE(diff.GetChangedInfoOnlyPaths().empty());
+}
+
+TEST(LayerDiffTest, Variant)
+{
+    auto layer1 = _CreateLayer();
+    auto layer2 = _CreateLayer(1, "", "", "Test");
+
+    unf::LayerDiff diff(layer1, layer2);
+    ASSERT_EQ(
+        diff.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/C"}});
+    ASSERT_TRUE(diff.GetChangedInfoOnlyPaths().empty());
+}
+
+TEST(LayerDiffTest, ReplaceLayerContent)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    auto layer = stage->GetRootLayer();
+    layer->TransferContent(_CreateLayer(1));
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage);
+
+    auto source = _CreateLayer(2);
+
+    unf::ReplaceLayerContent(broker, layer, source);
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& notice = observer.GetLatestNotice();
+    ASSERT_TRUE(notice.GetResyncedPaths().empty());
+    ASSERT_EQ(
+        notice.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/A.value"}});
+
+    // No notice is sent if the content is identical.
+    unf::ReplaceLayerContent(broker, layer, source);
+    ASSERT_EQ(observer.Received(), 1);
+}
+
+TEST(LayerDiffTest, ReloadLayer)
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string path = (directory / "unf_ReloadLayer.usda").string();
+
+    _CreateLayer()->Export(path);
+
+    auto stage = PXR_NS::UsdStage::Open(path);
+    auto broker = unf::Broker::Create(stage);
+    auto layer = stage->GetRootLayer();
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage);
+
+    _CreateLayer(1, "def \"E\" {}\n")->Export(path);
+
+    ASSERT_TRUE(unf::ReloadLayer(broker, layer, true));
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& notice = observer.GetLatestNotice();
+    ASSERT_EQ(
+        notice.GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/E"}});
+    ASSERT_TRUE(notice.GetChangedInfoOnlyPaths().empty());
+
+    std::remove(path.c_str());
+}
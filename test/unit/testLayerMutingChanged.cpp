@@ -0,0 +1,82 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+#include <unf/transaction.h>
+
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+
+class LayerMutingChangedTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+
+        _layer1 = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+        _layer1->ImportFromString(
+            "#usda 1.0\nover \"Foo\" {\n    def \"Bar\" {}\n}\n");
+
+        _layer2 = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+        _layer2->ImportFromString("#usda 1.0\ndef \"Baz\" {}\n");
+
+        auto root = _stage->GetRootLayer();
+        root->ImportFromString("#usda 1.0\ndef \"Foo\" {}\ndef \"Other\" {}\n");
+        root->SetSubLayerPaths(
+            {_layer1->GetIdentifier(), _layer2->GetIdentifier()});
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    PXR_NS::SdfLayerRefPtr _layer1;
+    PXR_NS::SdfLayerRefPtr _layer2;
+};
+
+TEST_F(LayerMutingChangedTest, GetAffectedPrimPaths)
+{
+    ::Test::Observer<unf::UnfNotice::LayerMutingChanged> observer(_stage);
+
+    _stage->MuteLayer(_layer1->GetIdentifier());
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Notice is received before the stage is recomposed.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetAffectedPrimPaths(),
+        PXR_NS::SdfPathVector({
+            PXR_NS::SdfPath{"/Foo"},
+            PXR_NS::SdfPath{"/Foo/Bar"},
+        }));
+}
+
+TEST_F(LayerMutingChangedTest, GetAffectedPrimPathsMerged)
+{
+    _stage->MuteLayer(_layer2->GetIdentifier());
+
+    ::Test::Observer<unf::UnfNotice::LayerMutingChanged> observer(_stage);
+
+    {
+        unf::NoticeTransaction transaction(_broker);
+
+        _stage->MuteLayer(_layer1->GetIdentifier());
+        _stage->UnmuteLayer(_layer2->GetIdentifier());
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Prims are inspected once the stage is recomposed, so "/Foo/Bar" is
+    // not reported anymore.
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetAffectedPrimPaths(),
+        PXR_NS::SdfPathVector({
+            PXR_NS::SdfPath{"/Baz"},
+            PXR_NS::SdfPath{"/Foo"},
+        }));
+}
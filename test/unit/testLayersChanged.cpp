@@ -0,0 +1,119 @@
+#include <unf/broker.h>
+#include <unf/dispatcher.h>
+#include <unf/notice.h>
+
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class LayersChangedTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+        _rootId = _stage->GetRootLayer()->GetIdentifier();
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    std::string _rootId;
+};
+
+TEST_F(LayersChangedTest, NotAddedByDefault)
+{
+    ::Test::Observer<unf::UnfNotice::LayersChanged> observer(_stage);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ASSERT_EQ(observer.Received(), 0);
+}
+
+TEST_F(LayersChangedTest, GetChangedPaths)
+{
+    _broker->AddDispatcher<unf::LayerDispatcher>();
+
+    ::Test::Observer<unf::UnfNotice::LayersChanged> observer(_stage);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(n.GetLayers(), std::vector<std::string>{_rootId});
+
+    const auto paths = n.GetChangedPaths(_rootId);
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Foo"}),
+        paths.end());
+    ASSERT_EQ(n.GetChangedPaths("incorrect"), PXR_NS::SdfPathVector{});
+}
+
+TEST_F(LayersChangedTest, GetChangedFields)
+{
+    _broker->AddDispatcher<unf::LayerDispatcher>();
+
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::LayersChanged> observer(_stage);
+
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_TRUE(n.HasChangedFields(_rootId, PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_FALSE(n.HasChangedFields(_rootId, PXR_NS::SdfPath{"/Incorrect"}));
+    const auto tokens = n.GetChangedFields(_rootId, PXR_NS::SdfPath{"/Foo"});
+    ASSERT_NE(tokens.find(PXR_NS::TfToken{"comment"}), tokens.end());
+}
+
+TEST_F(LayersChangedTest, IgnoreUnusedLayers)
+{
+    _broker->AddDispatcher<unf::LayerDispatcher>();
+
+    ::Test::Observer<unf::UnfNotice::LayersChanged> observer(_stage);
+
+    auto layer = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+    layer->ImportFromString("#usda 1.0\ndef \"Foo\" {}\n");
+
+    ASSERT_EQ(observer.Received(), 0);
+}
+
+TEST_F(LayersChangedTest, Merging)
+{
+    _broker->AddDispatcher<unf::LayerDispatcher>();
+
+    ::Test::Observer<unf::UnfNotice::LayersChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Paths from all layer edits are consolidated in lexicographical order.
+    const auto paths = n.GetChangedPaths(_rootId);
+    ASSERT_TRUE(std::is_sorted(paths.begin(), paths.end()));
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Foo"}),
+        paths.end());
+    ASSERT_NE(
+        std::find(paths.begin(), paths.end(), PXR_NS::SdfPath{"/Bar"}),
+        paths.end());
+
+    const auto tokens = n.GetChangedFields(_rootId, PXR_NS::SdfPath{"/Foo"});
+    ASSERT_NE(tokens.find(PXR_NS::TfToken{"comment"}), tokens.end());
+}
@@ -0,0 +1,199 @@
+#include <unf/broker.h>
+#include <unf/dispatcher.h>
+#include <unf/notice.h>
+
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/notice.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+
+// Dispatcher counting the number of times it was registered.
+class CountingDispatcher : public unf::Dispatcher {
+  public:
+    CountingDispatcher(const unf::BrokerWeakPtr& broker)
+        : unf::Dispatcher(broker)
+    {
+    }
+
+    std::string GetIdentifier() const override
+    {
+        return "CountingDispatcher";
+    }
+
+    void Register() override
+    {
+        _registered++;
+        _Register<
+            PXR_NS::UsdNotice::ObjectsChanged,
+            unf::UnfNotice::ObjectsChanged>();
+    }
+
+    size_t Registered() const { return _registered; }
+
+  private:
+    size_t _registered = 0;
+};
+
+class LazyRegistrationTest : public ::testing::Test {
+  protected:
+    using ObjectsChangedObserver =
+        ::Test::Observer<unf::UnfNotice::ObjectsChanged>;
+    using ContentsChangedObserver =
+        ::Test::Observer<unf::UnfNotice::StageContentsChanged>;
+
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+        _broker->SetLazyRegistration(true);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    void _DefinePrim()
+    {
+        _stage->DefinePrim(PXR_NS::SdfPath("/Foo" + std::to_string(_index++)));
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    int _index = 0;
+};
+
+TEST_F(LazyRegistrationTest, Default)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+    ASSERT_FALSE(broker->IsLazyRegistrationEnabled());
+    ASSERT_TRUE(
+        broker->IsRequested(
+            PXR_NS::TfType::Find<unf::UnfNotice::LayerMutingChanged>()));
+
+    ObjectsChangedObserver observer(stage);
+    stage->DefinePrim(PXR_NS::SdfPath("/Foo"));
+    ASSERT_EQ(observer.Received(), 1);
+}
+
+TEST_F(LazyRegistrationTest, NotRequested)
+{
+    ASSERT_TRUE(_broker->IsLazyRegistrationEnabled());
+    ASSERT_FALSE(
+        _broker->IsRequested(
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+
+    ObjectsChangedObserver observer(_stage);
+    _DefinePrim();
+    ASSERT_EQ(observer.Received(), 0);
+
+    // All dispatchers are registered again when disabled.
+    _broker->SetLazyRegistration(false);
+    _DefinePrim();
+    ASSERT_EQ(observer.Received(), 1);
+}
+
+TEST_F(LazyRegistrationTest, RequestNotices)
+{
+    ObjectsChangedObserver observer1(_stage);
+    ContentsChangedObserver observer2(_stage);
+
+    _broker->RequestNotices<unf::UnfNotice::ObjectsChanged>();
+    _broker->RequestNotices<unf::UnfNotice::ObjectsChanged>();
+
+    _DefinePrim();
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 0);
+
+    // Requests are counted.
+    _broker->ReleaseNotices<unf::UnfNotice::ObjectsChanged>();
+    _DefinePrim();
+    ASSERT_EQ(observer1.Received(), 2);
+
+    _broker->ReleaseNotices<unf::UnfNotice::ObjectsChanged>();
+    _DefinePrim();
+    ASSERT_EQ(observer1.Received(), 2);
+    ASSERT_EQ(observer2.Received(), 0);
+}
+
+TEST_F(LazyRegistrationTest, RequestBaseType)
+{
+    ObjectsChangedObserver observer1(_stage);
+    ContentsChangedObserver observer2(_stage);
+
+    _broker->RequestNotices<unf::UnfNotice::StageNotice>();
+
+    _DefinePrim();
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    _broker->ReleaseNotices<unf::UnfNotice::StageNotice>();
+}
+
+TEST_F(LazyRegistrationTest, Listener)
+{
+    size_t received = 0;
+    const size_t key =
+        _broker->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+            [&](const unf::UnfNotice::ObjectsChanged&) { received++; });
+
+    _DefinePrim();
+    ASSERT_EQ(received, 1);
+
+    _broker->RemoveConcurrentListener(key);
+
+    _DefinePrim();
+    ASSERT_EQ(received, 1);
+}
+
+TEST_F(LazyRegistrationTest, UnchangedRequests)
+{
+    using CountingDispatcherPtr = PXR_NS::TfRefPtr<CountingDispatcher>;
+
+    _broker->AddDispatcher<CountingDispatcher>();
+    auto dispatcher = PXR_NS::TfDynamic_cast<CountingDispatcherPtr>(
+        _broker->GetDispatcher("CountingDispatcher"));
+    ASSERT_TRUE(dispatcher);
+    ASSERT_EQ(dispatcher->Registered(), 1);
+
+    // Requesting other notice types does not register the dispatcher again.
+    _broker->RequestNotices<unf::UnfNotice::LayerMutingChanged>();
+    ASSERT_EQ(dispatcher->Registered(), 1);
+
+    _broker->RequestNotices<unf::UnfNotice::ObjectsChanged>();
+    ASSERT_EQ(dispatcher->Registered(), 2);
+
+    // Already registered dispatcher is not registered again.
+    const size_t key =
+        _broker->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+            [](const unf::UnfNotice::ObjectsChanged&) {});
+    _broker->BeginTransaction();
+    _broker->EndTransaction();
+    _broker->RemoveConcurrentListener(key);
+    ASSERT_EQ(dispatcher->Registered(), 2);
+
+    _broker->ReleaseNotices<unf::UnfNotice::ObjectsChanged>();
+    ASSERT_EQ(dispatcher->Registered(), 3);
+
+    _broker->ReleaseNotices<unf::UnfNotice::LayerMutingChanged>();
+    ASSERT_EQ(dispatcher->Registered(), 3);
+}
+
+TEST_F(LazyRegistrationTest, Transaction)
+{
+    ObjectsChangedObserver observer(_stage);
+
+    _broker->BeginTransaction();
+    _DefinePrim();
+    _DefinePrim();
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    _DefinePrim();
+    ASSERT_EQ(observer.Received(), 1);
+}
@@ -4,14 +4,20 @@
 #include <unfTest/observer.h>
 
 #include <gtest/gtest.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/primSpec.h>
 #include <pxr/usd/sdf/valueTypeName.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/prim.h>
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 class ObjectsChangedTest : public ::testing::Test {
   protected:
     void SetUp() override
@@ -301,3 +307,465 @@ TEST_F(ObjectsChangedTest, MergingResyncAndChangeInfo)
     ASSERT_NE(tokens.find(PXR_NS::TfToken{"specifier"}), tokens.end());
     ASSERT_NE(tokens.find(PXR_NS::TfToken{"typeName"}), tokens.end());
 }
+
+TEST_F(ObjectsChangedTest, Split)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/C"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/A"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/B"});
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    const auto chunks = n.Split(2);
+    ASSERT_EQ(chunks.size(), 3);
+
+    // Resynced paths are delivered first in lexicographical order.
+    ASSERT_EQ(
+        chunks[0]->GetResyncedPaths(),
+        (PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/A"}, PXR_NS::SdfPath{"/B"}}));
+    ASSERT_EQ(chunks[0]->GetChangedInfoOnlyPaths().size(), 0);
+
+    ASSERT_EQ(
+        chunks[1]->GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/C"}});
+    ASSERT_EQ(chunks[1]->GetChangedInfoOnlyPaths().size(), 0);
+
+    ASSERT_EQ(chunks[2]->GetResyncedPaths().size(), 0);
+    ASSERT_EQ(
+        chunks[2]->GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    ASSERT_EQ(
+        chunks[2]->GetChangedFields(PXR_NS::SdfPath{"/Foo"}),
+        n.GetChangedFields(PXR_NS::SdfPath{"/Foo"}));
+
+    // Notice is copied when it does not need to be split.
+    ASSERT_EQ(n.Split(0).size(), 1);
+    ASSERT_EQ(n.Split(4).size(), 1);
+    ASSERT_EQ(n.Split(4)[0]->GetResyncedPaths().size(), 3);
+}
+
+TEST_F(ObjectsChangedTest, DerivedViews)
+{
+    auto prim1 = _stage->DefinePrim(
+        PXR_NS::SdfPath{"/Foo"}, PXR_NS::TfToken("Cylinder"));
+    auto attribute = prim1.GetAttribute(PXR_NS::TfToken("radius"));
+    attribute.Set(1.0);
+
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    attribute.Set(5.0);
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Baz"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Baz/Child"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Descendant paths are removed when resynced paths are accessed.
+    ASSERT_EQ(
+        n.GetResyncedPaths(), PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Baz"}});
+    ASSERT_EQ(
+        n.GetResyncedPrimPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Baz"}});
+
+    const auto& properties = n.GetChangedPropertiesByPrim();
+    ASSERT_EQ(properties.size(), 1);
+    ASSERT_EQ(
+        properties.at(PXR_NS::SdfPath{"/Foo"}),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo.radius"}});
+
+    ASSERT_EQ(
+        n.GetValueChangedPrimPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+    ASSERT_EQ(
+        n.GetMetadataChangedPrimPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Bar"}});
+
+    ASSERT_EQ(
+        n.GetAffectedPrimPaths(),
+        (PXR_NS::SdfPathVector{
+            PXR_NS::SdfPath{"/Bar"},
+            PXR_NS::SdfPath{"/Baz"},
+            PXR_NS::SdfPath{"/Foo"}}));
+
+    // Views are only computed once.
+    ASSERT_EQ(&n.GetAffectedPrimPaths(), &n.GetAffectedPrimPaths());
+    ASSERT_EQ(&n.GetChangedPropertiesByPrim(), &properties);
+}
+
+TEST_F(ObjectsChangedTest, ChangeCategories)
+{
+    auto prim1 = _stage->DefinePrim(
+        PXR_NS::SdfPath{"/Foo"}, PXR_NS::TfToken("Cylinder"));
+    auto radius = prim1.GetAttribute(PXR_NS::TfToken("radius"));
+    auto height = prim1.GetAttribute(PXR_NS::TfToken("height"));
+    radius.Set(1.0);
+    height.Set(1.0);
+
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Time sample edits only.
+    height.Set(2.0, PXR_NS::UsdTimeCode(1));
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetChangeCategories(),
+        unf::ChangeCategory::TimeSamples);
+
+    _broker->BeginTransaction();
+    radius.Set(5.0);
+    radius.Set(6.0, PXR_NS::UsdTimeCode(1));
+    prim2.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Baz"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 2);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Categories of each notice are preserved when notices are merged.
+    ASSERT_EQ(
+        n.GetChangeCategories(PXR_NS::SdfPath{"/Foo.radius"}),
+        unf::ChangeCategory::Value | unf::ChangeCategory::TimeSamples);
+    ASSERT_EQ(
+        n.GetChangeCategories(PXR_NS::SdfPath{"/Bar"}),
+        unf::ChangeCategory::Metadata);
+    ASSERT_EQ(
+        n.GetChangeCategories(PXR_NS::SdfPath{"/Baz"}),
+        unf::ChangeCategory::Structure);
+    ASSERT_EQ(
+        n.GetChangeCategories(PXR_NS::SdfPath{"/Foo"}),
+        unf::ChangeCategory::None);
+
+    ASSERT_EQ(
+        n.GetChangeCategories(),
+        unf::ChangeCategory::Structure | unf::ChangeCategory::Value
+            | unf::ChangeCategory::TimeSamples
+            | unf::ChangeCategory::Metadata);
+
+    ASSERT_EQ(n.GetChangeCategoryMap().size(), 3);
+}
+
+TEST_F(ObjectsChangedTest, BatchQueries)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto attribute = prim.CreateAttribute(
+        PXR_NS::TfToken{"attr"}, PXR_NS::SdfValueTypeNames->Int);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/A"});
+    attribute.Set(1);
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Paths are not sorted.
+    const PXR_NS::SdfPathVector paths = {
+        PXR_NS::SdfPath{"/Incorrect"},
+        PXR_NS::SdfPath{"/Foo.attr"},
+        PXR_NS::SdfPath{"/A/B/C"},
+        PXR_NS::SdfPath{"/Foo"},
+        PXR_NS::SdfPath{"/A"},
+        PXR_NS::SdfPath{"/Foo/Child"},
+    };
+
+    ASSERT_EQ(
+        n.QueryResynced(paths),
+        std::vector<bool>({false, false, true, false, true, false}));
+    ASSERT_EQ(
+        n.QueryChangedInfoOnly(paths),
+        std::vector<bool>({false, true, false, true, false, true}));
+    ASSERT_EQ(
+        n.QueryAffected(paths),
+        std::vector<bool>({false, true, true, true, true, true}));
+    ASSERT_EQ(
+        n.QueryHasChangedFields(paths),
+        std::vector<bool>({false, true, false, true, true, false}));
+
+    // Categories of ancestors are included.
+    ASSERT_EQ(
+        n.QueryChangeCategories(paths),
+        std::vector<unf::ChangeCategory>({
+            unf::ChangeCategory::None,
+            unf::ChangeCategory::Value | unf::ChangeCategory::Metadata,
+            unf::ChangeCategory::Structure,
+            unf::ChangeCategory::Metadata,
+            unf::ChangeCategory::Structure,
+            unf::ChangeCategory::Metadata,
+        }));
+}
+
+TEST_F(ObjectsChangedTest, BatchQueriesParallel)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Root"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    for (int i = 0; i < 100; i += 2) {
+        _stage->DefinePrim(
+            PXR_NS::SdfPath{"/Root/Prim" + std::to_string(i)});
+    }
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+
+    // Query enough paths to be processed in several ranges, in reverse
+    // order.
+    PXR_NS::SdfPathVector paths;
+    std::vector<bool> expected;
+    for (int i = 99; i >= 0; --i) {
+        const PXR_NS::SdfPath prim("/Other/Prim" + std::to_string(i));
+        for (int j = 0; j < 100; ++j) {
+            const PXR_NS::SdfPath child =
+                prim.AppendChild(PXR_NS::TfToken("Child" + std::to_string(j)));
+            paths.push_back(child);
+            expected.push_back(false);
+        }
+    }
+    for (int i = 99; i >= 0; --i) {
+        const PXR_NS::SdfPath prim("/Root/Prim" + std::to_string(i));
+        for (int j = 0; j < 100; ++j) {
+            const PXR_NS::SdfPath child =
+                prim.AppendChild(PXR_NS::TfToken("Child" + std::to_string(j)));
+            paths.push_back(child);
+            expected.push_back(i % 2 == 0);
+        }
+    }
+
+    ASSERT_EQ(n.QueryResynced(paths), expected);
+    ASSERT_EQ(n.QueryAffected(paths), expected);
+
+    // Sorted paths are queried in place.
+    std::sort(paths.begin(), paths.end());
+    const auto result = n.QueryResynced(paths);
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const PXR_NS::SdfPath prim = paths[i].GetParentPath();
+        const bool resynced =
+            n.GetChangeCategories(prim) != unf::ChangeCategory::None;
+        ASSERT_EQ(result[i], resynced);
+    }
+}
+
+TEST_F(ObjectsChangedTest, GetMemoryUsage)
+{
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ASSERT_EQ(observer.Received(), 1);
+    const size_t size = observer.GetLatestNotice().GetMemoryUsage();
+    ASSERT_GT(size, sizeof(unf::UnfNotice::ObjectsChanged));
+
+    // Derived data is only allocated once queried.
+    auto notice = observer.GetLatestNotice().Clone();
+    const size_t _size = notice->GetMemoryUsage();
+    notice->GetAffectedPrimPaths();
+    ASSERT_GT(notice->GetMemoryUsage(), _size);
+
+    ASSERT_EQ(_broker->GetMemoryUsage(), 0);
+
+    _broker->BeginTransaction();
+    for (int i = 0; i < 10; ++i) {
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Bar" + std::to_string(i)});
+    }
+
+    // Captured notices are accounted until the transaction ends.
+    const size_t peak = _broker->GetMemoryUsage();
+    ASSERT_GT(peak, size);
+
+    _broker->EndTransaction();
+
+    ASSERT_EQ(_broker->GetMemoryUsage(), 0);
+    ASSERT_EQ(observer.Received(), 2);
+    ASSERT_GT(observer.GetLatestNotice().GetMemoryUsage(), size);
+}
+
+TEST_F(ObjectsChangedTest, Trim)
+{
+    auto prim1 = _stage->DefinePrim(PXR_NS::SdfPath{"/World/A"});
+    auto prim2 = _stage->DefinePrim(PXR_NS::SdfPath{"/World/B"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    prim1.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    prim1.SetMetadata(PXR_NS::TfToken{"documentation"}, "This is a test");
+    prim2.SetMetadata(PXR_NS::TfToken{"documentation"}, "This is a test");
+    _stage->DefinePrim(PXR_NS::SdfPath{"/World/A/Child"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Other"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    auto notice = observer.GetLatestNotice().Clone();
+    ASSERT_TRUE(notice->Trim(
+        {PXR_NS::SdfPath{"/World/A"}}, {PXR_NS::TfToken{"documentation"}}));
+
+    ASSERT_EQ(
+        notice->GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/World/A/Child"}});
+    ASSERT_EQ(
+        notice->GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/World/A"}});
+    ASSERT_EQ(
+        notice->GetChangedFields(PXR_NS::SdfPath{"/World/A"}),
+        unf::TfTokenSet{PXR_NS::TfToken{"comment"}});
+
+    // Paths with only ignored fields are removed.
+    notice = observer.GetLatestNotice().Clone();
+    ASSERT_TRUE(notice->Trim({}, {PXR_NS::TfToken{"documentation"}}));
+    ASSERT_EQ(
+        notice->GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/World/A"}});
+    ASSERT_EQ(notice->GetResyncedPaths().size(), 2);
+
+    // Resynced ancestors of subtrees are kept.
+    notice = observer.GetLatestNotice().Clone();
+    ASSERT_TRUE(notice->Trim({PXR_NS::SdfPath{"/Other/Child"}}, {}));
+    ASSERT_EQ(
+        notice->GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Other"}});
+    ASSERT_TRUE(notice->GetChangedInfoOnlyPaths().empty());
+
+    notice = observer.GetLatestNotice().Clone();
+    ASSERT_FALSE(notice->Trim({PXR_NS::SdfPath{"/Missing"}}, {}));
+}
+
+TEST_F(ObjectsChangedTest, CoarsenChildren)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/World"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Other"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    unf::CoarseningPolicy policy;
+    policy.maxChildren = 2;
+    _broker->SetCoarseningPolicy(policy);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/World/A"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/World/B"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/World/C"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Other/A"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_TRUE(n.IsCoarsened());
+    ASSERT_EQ(
+        n.GetResyncedPrimPaths(),
+        (PXR_NS::SdfPathVector{
+            PXR_NS::SdfPath{"/Other/A"}, PXR_NS::SdfPath{"/World"}}));
+
+    _broker->SetCoarseningPolicy(unf::CoarseningPolicy());
+}
+
+TEST_F(ObjectsChangedTest, CoarsenWithoutTransaction)
+{
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Root"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Notice sent outside of a transaction is never post-processed.
+    {
+        PXR_NS::SdfChangeBlock block;
+        PXR_NS::SdfCreatePrimInLayer(
+            _stage->GetRootLayer(), PXR_NS::SdfPath{"/Root/A"});
+        PXR_NS::SdfCreatePrimInLayer(
+            _stage->GetRootLayer(), PXR_NS::SdfPath{"/Root/B"});
+        PXR_NS::SdfCreatePrimInLayer(
+            _stage->GetRootLayer(), PXR_NS::SdfPath{"/Root/C"});
+        PXR_NS::SdfCreatePrimInLayer(
+            _stage->GetRootLayer(), PXR_NS::SdfPath{"/Z"});
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    unf::CoarseningPolicy policy;
+    policy.maxChildren = 2;
+
+    auto notice = observer.GetLatestNotice().Clone();
+    ASSERT_TRUE(notice->Coarsen(policy));
+
+    // Collapsed prims are resynced in lexicographical order.
+    ASSERT_EQ(
+        notice->GetResyncedPaths(),
+        (PXR_NS::SdfPathVector{
+            PXR_NS::SdfPath{"/Root"}, PXR_NS::SdfPath{"/Z"}}));
+
+    const auto prim = _stage->GetPrimAtPath(PXR_NS::SdfPath{"/Root/A"});
+    ASSERT_TRUE(prim);
+    ASSERT_TRUE(notice->ResyncedObject(prim));
+}
+
+TEST_F(ObjectsChangedTest, CoarsenBudget)
+{
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    unf::CoarseningPolicy policy;
+    policy.maxPaths = 2;
+    _broker->SetCoarseningPolicy(policy);
+
+    // Notice is not coarsened if it fits within the budget.
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/A/B/C"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/D"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_FALSE(observer.GetLatestNotice().IsCoarsened());
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/A/B/C/E"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/A/B/F"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/D/G"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 2);
+    ASSERT_TRUE(observer.GetLatestNotice().IsCoarsened());
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetResyncedPrimPaths(),
+        (PXR_NS::SdfPathVector{
+            PXR_NS::SdfPath{"/A/B"}, PXR_NS::SdfPath{"/D/G"}}));
+
+    // Changes are collapsed into the pseudo-root if required.
+    policy.maxPaths = 1;
+    policy.collapseToRoot = true;
+    _broker->SetCoarseningPolicy(policy);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/H"});
+    _stage->DefinePrim(PXR_NS::SdfPath{"/I"});
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 3);
+    ASSERT_TRUE(observer.GetLatestNotice().IsCoarsened());
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath::AbsoluteRootPath()});
+
+    _broker->SetCoarseningPolicy(unf::CoarseningPolicy());
+}
@@ -0,0 +1,167 @@
+#include <unf/broker.h>
+#include <unf/capturePredicate.h>
+#include <unf/notice.h>
+#include <unf/recorder.h>
+#include <unf/transaction.h>
+
+#include <unfTest/notice.h>
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+class RecorderTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+
+        const auto* test = ::testing::UnitTest::GetInstance();
+        const std::string name = test->current_test_info()->name();
+        const auto directory = std::filesystem::temp_directory_path();
+        _path = (directory / ("unf_" + name + ".unfr")).string();
+    }
+
+    void TearDown() override { std::remove(_path.c_str()); }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    std::string _path;
+};
+
+TEST_F(RecorderTest, Record)
+{
+    {
+        unf::NoticeRecorder recorder(_broker, _path);
+        ASSERT_TRUE(recorder.IsRecording());
+
+        // Only one recorder can be attached to a broker.
+        unf::NoticeRecorder recorder2(_broker, _path + ".2");
+        ASSERT_FALSE(recorder2.IsRecording());
+
+        _broker->Send<::Test::MergeableNotice>();
+
+        _broker->BeginTransaction();
+        _broker->Send<::Test::MergeableNotice>();
+        _broker->Send<::Test::UnMergeableNotice>();
+        _broker->EndTransaction();
+
+        // Send, BeginTransaction, 2 x (Send, Capture), EndTransaction
+        ASSERT_EQ(recorder.GetEventCount(), 7);
+
+        recorder.Stop();
+        ASSERT_FALSE(recorder.IsRecording());
+
+        _broker->Send<::Test::MergeableNotice>();
+        ASSERT_EQ(recorder.GetEventCount(), 7);
+    }
+
+    unf::NoticeRecording recording(_path);
+    ASSERT_TRUE(recording.IsValid());
+    ASSERT_EQ(recording.GetEventCount(), 7);
+    ASSERT_EQ(recording.GetNoticeCount(), 3);
+}
+
+TEST_F(RecorderTest, Replay)
+{
+    {
+        unf::NoticeRecorder recorder(_broker, _path);
+
+        _broker->Send<::Test::MergeableNotice>(
+            ::Test::DataMap{{"Foo", "Test1"}});
+
+        _broker->BeginTransaction([](const unf::UnfNotice::StageNotice& n) {
+            auto& notice = static_cast<const ::Test::MergeableNotice&>(n);
+            return notice.GetData().count("Skip") == 0;
+        });
+
+        _broker->Send<::Test::MergeableNotice>(
+            ::Test::DataMap{{"Foo", "Test2"}});
+        _broker->Send<::Test::MergeableNotice>(
+            ::Test::DataMap{{"Skip", "Test3"}});
+        _broker->Send<::Test::MergeableNotice>(
+            ::Test::DataMap{{"Bar", "Test4"}});
+
+        _broker->EndTransaction();
+    }
+
+    unf::NoticeRecording recording(_path);
+    ASSERT_TRUE(recording.IsValid());
+
+    // Replay on a new stage.
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    ::Test::Observer<::Test::MergeableNotice> observer(stage);
+
+    // Replay twice to ensure that recorded notices are not modified.
+    for (size_t i = 1; i <= 2; ++i) {
+        ASSERT_EQ(recording.Replay(broker), 4);
+        ASSERT_EQ(observer.Received(), i * 2);
+        ASSERT_FALSE(broker->IsInTransaction());
+
+        const auto& n = observer.GetLatestNotice();
+        ASSERT_EQ(
+            n.GetData(),
+            (::Test::DataMap{{"Foo", "Test2"}, {"Bar", "Test4"}}));
+    }
+}
+
+TEST_F(RecorderTest, ReplayTrimmed)
+{
+    {
+        unf::NoticeRecorder recorder(_broker, _path);
+
+        unf::NoticeTransaction transaction(
+            _broker,
+            unf::CapturePredicate::Trimming({PXR_NS::SdfPath{"/Foo"}}, {}));
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    }
+
+    unf::NoticeRecording recording(_path);
+    ASSERT_TRUE(recording.IsValid());
+
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage);
+
+    // Notices are recorded after being trimmed.
+    recording.Replay(broker);
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+}
+
+TEST_F(RecorderTest, ExpiredBroker)
+{
+    unf::NoticeRecorder recorder(_broker, _path);
+    ASSERT_TRUE(recorder.IsRecording());
+
+    // Recorder does not keep the broker alive, and can be destroyed after
+    // the broker.
+    _broker->Reset();
+    _broker.Reset();
+}
+
+TEST_F(RecorderTest, InvalidBroker)
+{
+    unf::NoticeRecorder recorder(unf::BrokerWeakPtr(), _path);
+    ASSERT_FALSE(recorder.IsRecording());
+}
+
+TEST_F(RecorderTest, InvalidFile)
+{
+    unf::NoticeRecording recording(_path + ".missing");
+    ASSERT_FALSE(recording.IsValid());
+    ASSERT_EQ(recording.Replay(_broker), 0);
+}
@@ -0,0 +1,193 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+#include <unf/serialization.h>
+
+#include <unfTest/notice.h>
+#include <unfTest/observer.h>
+
+#include <gtest/gtest.h>
+#include <pxr/base/tf/refPtr.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+#include <vector>
+
+class SerializationTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+    }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+};
+
+TEST_F(SerializationTest, Header)
+{
+    const auto buffer = unf::NoticeSerializer::Serialize(
+        {unf::UnfNotice::StageContentsChanged::Create(),
+         unf::UnfNotice::StageEditTargetChanged::Create()});
+
+    unf::SerializedNotices notices(buffer);
+    ASSERT_TRUE(notices.IsValid());
+    ASSERT_EQ(notices.GetVersion(), unf::NoticeSerializer::Version);
+    ASSERT_EQ(notices.size(), 2);
+    ASSERT_EQ(
+        notices.GetTypeId(0),
+        unf::UnfNotice::StageContentsChanged::Create()->GetTypeId());
+    ASSERT_EQ(
+        notices.GetTypeId(1),
+        unf::UnfNotice::StageEditTargetChanged::Create()->GetTypeId());
+
+    const auto result = notices.DeserializeAll();
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_EQ(result[0]->GetTypeId(), notices.GetTypeId(0));
+    ASSERT_EQ(result[1]->GetTypeId(), notices.GetTypeId(1));
+}
+
+TEST_F(SerializationTest, InvalidBuffer)
+{
+    std::vector<char> buffer = {'a', 'b', 'c'};
+
+    unf::SerializedNotices notices1(buffer);
+    ASSERT_FALSE(notices1.IsValid());
+    ASSERT_EQ(notices1.size(), 0);
+
+    buffer = unf::NoticeSerializer::Serialize(
+        {unf::UnfNotice::StageContentsChanged::Create()});
+    buffer[4] = 99;
+
+    unf::SerializedNotices notices2(buffer);
+    ASSERT_FALSE(notices2.IsValid());
+    ASSERT_EQ(notices2.size(), 0);
+}
+
+TEST_F(SerializationTest, ObjectsChanged)
+{
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    _broker->BeginTransaction();
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+    _broker->EndTransaction();
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    const auto buffer = unf::NoticeSerializer::Serialize({n.Clone()});
+
+    unf::SerializedNotices notices(buffer);
+    ASSERT_TRUE(notices.IsValid());
+    ASSERT_EQ(notices.size(), 1);
+
+    // Query data in place.
+    unf::ObjectsChangedView view(notices.GetReader(0));
+    ASSERT_TRUE(view.IsValid());
+    ASSERT_TRUE(view.ResyncedPath(PXR_NS::SdfPath{"/Bar"}));
+    ASSERT_TRUE(view.ResyncedPath(PXR_NS::SdfPath{"/Bar.attr"}));
+    ASSERT_FALSE(view.ResyncedPath(PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_TRUE(view.ChangedInfoOnly(PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_FALSE(view.AffectedPath(PXR_NS::SdfPath{"/Baz"}));
+    ASSERT_TRUE(view.HasChangedFields(PXR_NS::SdfPath{"/Foo"}));
+
+    const auto fields = view.GetChangedFields(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(fields, n.GetChangedFields(PXR_NS::SdfPath{"/Foo"}));
+
+    // Re-create notice.
+    using ObjectsChangedPtr = PXR_NS::TfRefPtr<unf::UnfNotice::ObjectsChanged>;
+    auto _n = PXR_NS::TfDynamic_cast<ObjectsChangedPtr>(notices.Deserialize(0));
+    ASSERT_TRUE(_n);
+    ASSERT_EQ(_n->GetResyncedPaths(), n.GetResyncedPaths());
+    ASSERT_EQ(_n->GetChangedInfoOnlyPaths(), n.GetChangedInfoOnlyPaths());
+    ASSERT_EQ(
+        _n->GetChangedFields(PXR_NS::SdfPath{"/Foo"}),
+        n.GetChangedFields(PXR_NS::SdfPath{"/Foo"}));
+    ASSERT_EQ(_n->GetChangeCategoryMap(), n.GetChangeCategoryMap());
+    ASSERT_EQ(_n->GetChangeCategories(), n.GetChangeCategories());
+}
+
+TEST_F(SerializationTest, LayerMutingChanged)
+{
+    auto layer1 = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+    auto layer2 = PXR_NS::SdfLayer::CreateAnonymous(".usda");
+
+    _stage->GetRootLayer()->GetSubLayerPaths().push_back(
+        layer1->GetIdentifier());
+    _stage->GetRootLayer()->GetSubLayerPaths().push_back(
+        layer2->GetIdentifier());
+
+    _stage->MuteLayer(layer1->GetIdentifier());
+
+    ::Test::Observer<unf::UnfNotice::LayerMutingChanged> observer(_stage);
+
+    _stage->MuteAndUnmuteLayers(
+        {layer2->GetIdentifier()}, {layer1->GetIdentifier()});
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    const auto buffer = unf::NoticeSerializer::Serialize({n.Clone()});
+
+    unf::SerializedNotices notices(buffer);
+    using LayerMutingChangedPtr =
+        PXR_NS::TfRefPtr<unf::UnfNotice::LayerMutingChanged>;
+    auto _n =
+        PXR_NS::TfDynamic_cast<LayerMutingChangedPtr>(notices.Deserialize(0));
+    ASSERT_TRUE(_n);
+    ASSERT_EQ(_n->GetMutedLayers(), n.GetMutedLayers());
+    ASSERT_EQ(_n->GetUnmutedLayers(), n.GetUnmutedLayers());
+}
+
+TEST_F(SerializationTest, CustomNotice)
+{
+    auto notice = ::Test::MergeableNotice::Create(
+        ::Test::DataMap{{"Foo", "Test1"}, {"Bar", "Test2"}});
+
+    const auto buffer = unf::NoticeSerializer::Serialize(
+        {notice, ::Test::UnMergeableNotice::Create()});
+
+    // Notices which cannot be serialized are skipped.
+    unf::SerializedNotices notices(buffer);
+    ASSERT_EQ(notices.size(), 1);
+
+    using MergeableNoticePtr = PXR_NS::TfRefPtr<::Test::MergeableNotice>;
+    auto _notice =
+        PXR_NS::TfDynamic_cast<MergeableNoticePtr>(notices.Deserialize(0));
+    ASSERT_TRUE(_notice);
+    ASSERT_EQ(_notice->GetData(), notice->GetData());
+}
+
+TEST_F(SerializationTest, PathTable)
+{
+    PXR_NS::SdfPathVector paths;
+    for (int i = 0; i < 50; ++i) {
+        paths.push_back(PXR_NS::SdfPath{"/Root/Prim" + std::to_string(i)});
+    }
+    paths.push_back(PXR_NS::SdfPath{"/Root/Prim0.attr"});
+
+    unf::NoticeWriter writer;
+    writer.WritePaths(paths);
+
+    const auto& data = writer.GetData();
+    unf::NoticeReader reader(data.data(), data.size(), nullptr, 0);
+    const auto table = reader.ReadPaths();
+    ASSERT_TRUE(reader.IsValid());
+    ASSERT_EQ(table.size(), paths.size());
+
+    for (const auto& path : paths) {
+        ASSERT_TRUE(table.Contains(path));
+        ASSERT_EQ(table.GetPath(table.Find(path)), path);
+    }
+    ASSERT_FALSE(table.Contains(PXR_NS::SdfPath{"/Root"}));
+    ASSERT_FALSE(table.Contains(PXR_NS::SdfPath{"/Root/Prim50"}));
+    ASSERT_TRUE(table.ContainsPrefixOf(PXR_NS::SdfPath{"/Root/Prim7.attr"}));
+    ASSERT_FALSE(table.ContainsPrefixOf(PXR_NS::SdfPath{"/Other"}));
+}
@@ -0,0 +1,176 @@
+#include <unf/broker.h>
+#include <unf/notice.h>
+#include <unf/transaction.h>
+
+#include <unfTest/listener.h>
+#include <unfTest/notice.h>
+
+#include <gtest/gtest.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class SubscriptionTest : public ::testing::Test {
+  protected:
+    using Listener =
+        ::Test::Listener<::Test::MergeableNotice, ::Test::UnMergeableNotice>;
+
+    void SetUp() override
+    {
+        _stage = PXR_NS::UsdStage::CreateInMemory();
+        _broker = unf::Broker::Create(_stage);
+        _listener.SetStage(_stage);
+    }
+
+    void TearDown() override { _broker->Reset(); }
+
+    PXR_NS::UsdStageRefPtr _stage;
+    unf::BrokerPtr _broker;
+    Listener _listener;
+};
+
+TEST_F(SubscriptionTest, Subscribe)
+{
+    size_t received = 0;
+
+    {
+        unf::Subscription subscription =
+            _broker->Subscribe<::Test::MergeableNotice>(
+                [&](const ::Test::MergeableNotice&) { received++; });
+
+        ASSERT_TRUE(subscription.IsActive());
+
+        _broker->Send<::Test::MergeableNotice>();
+        ASSERT_EQ(received, 1);
+
+        _broker->Send<::Test::UnMergeableNotice>();
+        ASSERT_EQ(received, 1);
+
+        {
+            unf::NoticeTransaction transaction(_broker);
+
+            _broker->Send<::Test::MergeableNotice>();
+            _broker->Send<::Test::MergeableNotice>();
+            ASSERT_EQ(received, 1);
+        }
+
+        ASSERT_EQ(received, 2);
+    }
+
+    // Callback is unregistered when the handle is destroyed.
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 2);
+}
+
+TEST_F(SubscriptionTest, BaseType)
+{
+    size_t received = 0;
+
+    auto subscription = _broker->Subscribe<unf::UnfNotice::StageNotice>(
+        [&](const unf::UnfNotice::StageNotice&) { received++; });
+
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(received, 2);
+}
+
+TEST_F(SubscriptionTest, Order)
+{
+    std::vector<std::string> calls;
+
+    auto subscription1 = _broker->Subscribe<unf::UnfNotice::StageNotice>(
+        [&](const unf::UnfNotice::StageNotice&) { calls.push_back("base1"); });
+    auto subscription2 = _broker->Subscribe<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) { calls.push_back("derived"); });
+    auto subscription3 = _broker->Subscribe<unf::UnfNotice::StageNotice>(
+        [&](const unf::UnfNotice::StageNotice&) { calls.push_back("base2"); });
+
+    // Listeners are invoked in registration order across notice types.
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(
+        calls, std::vector<std::string>({"base1", "derived", "base2"}));
+
+    // Listeners invoked are updated when subscriptions change.
+    calls.clear();
+    subscription1.Reset();
+    _broker->Send<::Test::MergeableNotice>();
+    _broker->Send<::Test::UnMergeableNotice>();
+    ASSERT_EQ(calls, std::vector<std::string>({"derived", "base2", "base2"}));
+}
+
+TEST_F(SubscriptionTest, Move)
+{
+    size_t received = 0;
+
+    auto subscription1 = _broker->Subscribe<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) { received++; });
+
+    unf::Subscription subscription2(std::move(subscription1));
+    ASSERT_FALSE(subscription1.IsActive());
+    ASSERT_TRUE(subscription2.IsActive());
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+
+    unf::Subscription subscription3;
+    ASSERT_FALSE(subscription3.IsActive());
+
+    subscription3 = std::move(subscription2);
+    ASSERT_FALSE(subscription2.IsActive());
+    ASSERT_TRUE(subscription3.IsActive());
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 2);
+
+    subscription3.Reset();
+    ASSERT_FALSE(subscription3.IsActive());
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 2);
+}
+
+TEST_F(SubscriptionTest, ExpiredBroker)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+    auto broker = unf::Broker::Create(stage);
+
+    auto subscription = broker->Subscribe<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) {});
+    ASSERT_TRUE(subscription.IsActive());
+
+    broker->Reset();
+    broker.Reset();
+    ASSERT_FALSE(subscription.IsActive());
+
+    // Resetting handle after the broker is destroyed is safe.
+    subscription.Reset();
+}
+
+TEST_F(SubscriptionTest, TfNoticeDelivery)
+{
+    ASSERT_TRUE(_broker->IsTfNoticeDeliveryEnabled());
+
+    size_t received = 0;
+
+    auto subscription = _broker->Subscribe<::Test::MergeableNotice>(
+        [&](const ::Test::MergeableNotice&) { received++; });
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 1);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+
+    _broker->SetTfNoticeDelivery(false);
+    ASSERT_FALSE(_broker->IsTfNoticeDeliveryEnabled());
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 2);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+
+    subscription.Reset();
+
+    _broker->Send<::Test::MergeableNotice>();
+    ASSERT_EQ(received, 2);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+}
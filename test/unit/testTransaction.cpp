@@ -1,13 +1,22 @@
 #include <unf/broker.h>
 #include <unf/capturePredicate.h>
+#include <unf/notice.h>
 #include <unf/transaction.h>
 
 #include <unfTest/listener.h>
 #include <unfTest/notice.h>
+#include <unfTest/observer.h>
 
 #include <gtest/gtest.h>
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/type.h>
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/stage.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 class TransactionTest : public ::testing::Test {
   protected:
     using Listener =
@@ -376,3 +385,590 @@ TEST_F(TransactionTest, NestedWithFilter)
     ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
     ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 3);
 }
+
+TEST_F(TransactionTest, PreFilter)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    std::vector<PXR_NS::TfType> types;
+    auto preFilter = [&](const PXR_NS::TfNotice& notice,
+                         const PXR_NS::TfType& type) {
+        types.push_back(type);
+        return !type.IsA<unf::UnfNotice::ObjectsChanged>();
+    };
+
+    // Notices are always accepted outside of transactions.
+    ASSERT_TRUE(broker->Accepts(
+        PXR_NS::TfNotice(),
+        PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+
+    {
+        unf::NoticeTransaction transaction(
+            broker, unf::CapturePredicate(nullptr, preFilter));
+
+        ASSERT_FALSE(broker->Accepts(
+            PXR_NS::TfNotice(),
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()));
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    }
+
+    ASSERT_EQ(observer.Received(), 0);
+
+    // Pre-filter is called before each conversion.
+    ASSERT_NE(
+        std::find(
+            types.begin(),
+            types.end(),
+            PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>()),
+        types.end());
+}
+
+TEST_F(TransactionTest, PreFilterNested)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    {
+        unf::NoticeTransaction transaction1(
+            broker, unf::CapturePredicate::BlockAll());
+
+        // Only the innermost predicate is evaluated.
+        {
+            unf::NoticeTransaction transaction2(broker);
+            _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        }
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+}
+
+TEST_F(TransactionTest, AllowTypes)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+    ::Test::Observer<unf::UnfNotice::StageContentsChanged> observer2(_stage);
+
+    {
+        unf::NoticeTransaction transaction(
+            broker,
+            unf::CapturePredicate::AllowTypes(
+                {PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>(),
+                 PXR_NS::TfType::Find<::Test::MergeableNotice>()}));
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+        broker->Send<::Test::MergeableNotice>();
+        broker->Send<::Test::UnMergeableNotice>();
+    }
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 0);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+}
+
+TEST_F(TransactionTest, BlockTypes)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+    ::Test::Observer<unf::UnfNotice::StageContentsChanged> observer2(_stage);
+
+    {
+        unf::NoticeTransaction transaction(
+            broker,
+            unf::CapturePredicate::BlockTypes(
+                {PXR_NS::TfType::Find<unf::UnfNotice::ObjectsChanged>(),
+                 PXR_NS::TfType::Find<::Test::MergeableNotice>()}));
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+        broker->Send<::Test::MergeableNotice>();
+        broker->Send<::Test::UnMergeableNotice>();
+    }
+
+    ASSERT_EQ(observer1.Received(), 0);
+    ASSERT_EQ(observer2.Received(), 1);
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+}
+
+TEST_F(TransactionTest, Trimming)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    auto prim = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    {
+        unf::NoticeTransaction transaction(
+            broker,
+            unf::CapturePredicate::Trimming(
+                {PXR_NS::SdfPath{"/Foo"}},
+                {PXR_NS::TfToken{"documentation"}}));
+
+        prim.SetMetadata(PXR_NS::TfToken{"documentation"}, "This is a test");
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+    }
+
+    // Notices left without any path are dropped.
+    ASSERT_EQ(observer.Received(), 0);
+
+    {
+        unf::NoticeTransaction transaction(
+            broker,
+            unf::CapturePredicate::Trimming(
+                {PXR_NS::SdfPath{"/Foo"}},
+                {PXR_NS::TfToken{"documentation"}}));
+
+        prim.SetMetadata(PXR_NS::TfToken{"comment"}, "This is a test");
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Baz"});
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& notice = observer.GetLatestNotice();
+    ASSERT_TRUE(notice.GetResyncedPaths().empty());
+    ASSERT_EQ(
+        notice.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+}
+
+TEST_F(TransactionTest, TrimmingSharedNotice)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+    _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    ASSERT_EQ(observer.Received(), 1);
+
+    // Send notice which is referenced outside of the broker.
+    auto notice = observer.GetLatestNotice().Clone();
+    {
+        unf::NoticeTransaction transaction(
+            broker,
+            unf::CapturePredicate::Trimming({PXR_NS::SdfPath{"/Bar"}}, {}));
+
+        broker->Send(notice);
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+
+    // The notice sent is not modified.
+    ASSERT_EQ(
+        notice->GetResyncedPaths(),
+        PXR_NS::SdfPathVector{PXR_NS::SdfPath{"/Foo"}});
+}
+
+TEST_F(TransactionTest, MergePolicies)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    std::vector<int> latest;
+    std::vector<int> firstAndLast;
+    std::vector<int> ring;
+
+    broker->AddConcurrentListener<::Test::KeepLatestNotice>(
+        [&](const ::Test::KeepLatestNotice& notice) {
+            latest.push_back(notice.GetIndex());
+        });
+    broker->AddConcurrentListener<::Test::KeepFirstAndLastNotice>(
+        [&](const ::Test::KeepFirstAndLastNotice& notice) {
+            firstAndLast.push_back(notice.GetIndex());
+        });
+    broker->AddConcurrentListener<::Test::BoundedRingNotice>(
+        [&](const ::Test::BoundedRingNotice& notice) {
+            ring.push_back(notice.GetIndex());
+        });
+
+    {
+        unf::NoticeTransaction transaction(broker);
+
+        for (int index = 0; index < 10; ++index) {
+            broker->Send<::Test::KeepLatestNotice>(index);
+            broker->Send<::Test::KeepFirstAndLastNotice>(index);
+            broker->Send<::Test::BoundedRingNotice>(index);
+        }
+    }
+
+    ASSERT_EQ(latest, std::vector<int>({9}));
+    ASSERT_EQ(firstAndLast, std::vector<int>({0, 9}));
+    ASSERT_EQ(ring, std::vector<int>({7, 8, 9}));
+}
+
+TEST_F(TransactionTest, MergePoliciesNested)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    std::vector<int> firstAndLast;
+    std::vector<int> ring;
+
+    broker->AddConcurrentListener<::Test::KeepFirstAndLastNotice>(
+        [&](const ::Test::KeepFirstAndLastNotice& notice) {
+            firstAndLast.push_back(notice.GetIndex());
+        });
+    broker->AddConcurrentListener<::Test::BoundedRingNotice>(
+        [&](const ::Test::BoundedRingNotice& notice) {
+            ring.push_back(notice.GetIndex());
+        });
+
+    {
+        unf::NoticeTransaction transaction1(broker);
+
+        broker->Send<::Test::KeepFirstAndLastNotice>(0);
+        broker->Send<::Test::BoundedRingNotice>(0);
+        broker->Send<::Test::BoundedRingNotice>(1);
+
+        {
+            unf::NoticeTransaction transaction2(broker);
+
+            for (int index = 2; index < 6; ++index) {
+                broker->Send<::Test::KeepFirstAndLastNotice>(index);
+                broker->Send<::Test::BoundedRingNotice>(index);
+            }
+        }
+    }
+
+    ASSERT_EQ(firstAndLast, std::vector<int>({0, 5}));
+    ASSERT_EQ(ring, std::vector<int>({3, 4, 5}));
+}
+
+TEST_F(TransactionTest, CommitComposite)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetCommitDelivery(unf::Broker::CommitDelivery::Composite);
+
+    std::vector<std::vector<std::string> > batches;
+
+    broker->AddConcurrentListener<unf::UnfNotice::TransactionCommitted>(
+        [&](const unf::UnfNotice::TransactionCommitted& notice) {
+            std::vector<std::string> names;
+            for (const auto& _notice : notice.GetNotices()) {
+                names.push_back(_notice->GetTypeId());
+            }
+            batches.push_back(names);
+        });
+
+    {
+        unf::NoticeTransaction transaction(broker);
+
+        broker->Send<::Test::UnMergeableNotice>();
+        broker->Send<::Test::MergeableNotice>();
+
+        {
+            unf::NoticeTransaction transaction2(broker);
+
+            broker->Send<::Test::KeepLatestNotice>(0);
+            broker->Send<::Test::UnMergeableNotice>();
+            broker->Send<::Test::MergeableNotice>();
+        }
+
+        broker->Send<::Test::KeepLatestNotice>(1);
+    }
+
+    // Notices are only received within the composite notice, ordered by
+    // the first time their type was captured.
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 0);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 0);
+
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(
+        batches[0],
+        std::vector<std::string>({
+            "Test::UnMergeableNotice",
+            "Test::UnMergeableNotice",
+            "Test::MergeableNotice",
+            "Test::KeepLatestNotice",
+        }));
+
+    // No composite notice is sent if no notices were captured.
+    {
+        unf::NoticeTransaction transaction(broker);
+    }
+
+    ASSERT_EQ(batches.size(), 1);
+}
+
+TEST_F(TransactionTest, CommitBoth)
+{
+    auto broker = unf::Broker::Create(_stage);
+    broker->SetCommitDelivery(unf::Broker::CommitDelivery::Both);
+
+    std::vector<std::string> received;
+
+    broker->AddConcurrentListener<unf::UnfNotice::StageNotice>(
+        [&](const unf::UnfNotice::StageNotice& notice) {
+            received.push_back(notice.GetTypeId());
+        });
+
+    {
+        unf::NoticeTransaction transaction(broker);
+
+        broker->Send<::Test::MergeableNotice>();
+        broker->Send<::Test::UnMergeableNotice>();
+        broker->Send<::Test::MergeableNotice>();
+    }
+
+    ASSERT_EQ(_listener.Received<::Test::MergeableNotice>(), 1);
+    ASSERT_EQ(_listener.Received<::Test::UnMergeableNotice>(), 1);
+
+    ASSERT_EQ(
+        received,
+        std::vector<std::string>({
+            "Test::MergeableNotice",
+            "Test::UnMergeableNotice",
+            "unf::UnfNotice::TransactionCommitted",
+        }));
+}
+
+TEST_F(TransactionTest, ChangeBlock)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    auto foo = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto bar = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    // Count notices converted from USD and captured by the transaction.
+    size_t captured = 0;
+    auto predicate = [&](const unf::UnfNotice::StageNotice& notice) {
+        if (dynamic_cast<const unf::UnfNotice::ObjectsChanged*>(&notice)) {
+            captured++;
+        }
+        return true;
+    };
+
+    {
+        unf::NoticeTransaction transaction(
+            broker, predicate, unf::NoticeTransaction::Mode::ChangeBlock);
+        ASSERT_EQ(
+            transaction.GetMode(), unf::NoticeTransaction::Mode::ChangeBlock);
+
+        foo.SetMetadata(PXR_NS::TfToken{"comment"}, "A");
+        foo.SetMetadata(PXR_NS::TfToken{"documentation"}, "B");
+        bar.SetMetadata(PXR_NS::TfToken{"comment"}, "C");
+
+        // USD does not send notices until the change block is released.
+        ASSERT_EQ(captured, 0);
+    }
+
+    // Edits are coalesced by USD into a single notice.
+    ASSERT_EQ(captured, 1);
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector({
+            PXR_NS::SdfPath{"/Bar"},
+            PXR_NS::SdfPath{"/Foo"},
+        }));
+}
+
+TEST_F(TransactionTest, ChangeBlockNested)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    auto foo = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    auto bar = _stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    size_t captured = 0;
+    auto predicate = [&](const unf::UnfNotice::StageNotice& notice) {
+        if (dynamic_cast<const unf::UnfNotice::ObjectsChanged*>(&notice)) {
+            captured++;
+        }
+        return true;
+    };
+
+    {
+        unf::NoticeTransaction transaction1(
+            broker, predicate, unf::NoticeTransaction::Mode::ChangeBlock);
+
+        foo.SetMetadata(PXR_NS::TfToken{"comment"}, "A");
+
+        {
+            // Edits are sent by USD when the outermost change block is
+            // released, so this predicate is not used.
+            unf::NoticeTransaction transaction2(
+                broker,
+                unf::CapturePredicate::BlockAll(),
+                unf::NoticeTransaction::Mode::ChangeBlock);
+
+            bar.SetMetadata(PXR_NS::TfToken{"comment"}, "B");
+        }
+
+        ASSERT_EQ(captured, 0);
+        ASSERT_TRUE(broker->IsInTransaction());
+    }
+
+    ASSERT_EQ(captured, 1);
+    ASSERT_EQ(observer.Received(), 1);
+
+    const auto& n = observer.GetLatestNotice();
+    ASSERT_EQ(
+        n.GetChangedInfoOnlyPaths(),
+        PXR_NS::SdfPathVector({
+            PXR_NS::SdfPath{"/Bar"},
+            PXR_NS::SdfPath{"/Foo"},
+        }));
+}
+
+TEST_F(TransactionTest, ChangeBlockWithinTransaction)
+{
+    auto broker = unf::Broker::Create(_stage);
+
+    auto foo = _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(_stage);
+
+    {
+        unf::NoticeTransaction transaction1(broker);
+
+        {
+            unf::NoticeTransaction transaction2(
+                broker,
+                unf::CapturePredicate::Default(),
+                unf::NoticeTransaction::Mode::ChangeBlock);
+
+            foo.SetMetadata(PXR_NS::TfToken{"comment"}, "A");
+            foo.SetMetadata(PXR_NS::TfToken{"documentation"}, "B");
+        }
+
+        // Notice sent by USD is held by the outer transaction.
+        ASSERT_EQ(observer.Received(), 0);
+    }
+
+    ASSERT_EQ(observer.Received(), 1);
+}
+
+TEST_F(TransactionTest, MultiBroker)
+{
+    auto stage1 = PXR_NS::UsdStage::CreateInMemory();
+    auto stage2 = PXR_NS::UsdStage::CreateInMemory();
+
+    auto broker1 = unf::Broker::Create(stage1);
+    auto broker2 = unf::Broker::Create(stage2);
+
+    std::vector<std::string> received;
+
+    broker1->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+        [&](const unf::UnfNotice::ObjectsChanged&) {
+            received.push_back("stage1");
+        });
+
+    broker2->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+        [&](const unf::UnfNotice::ObjectsChanged&) {
+            received.push_back("stage2");
+        });
+
+    {
+        unf::MultiNoticeTransaction transaction(
+            std::vector<unf::BrokerPtr>{broker2, broker1, broker2});
+        ASSERT_EQ(
+            transaction.GetBrokers(),
+            std::vector<unf::BrokerPtr>({broker2, broker1}));
+
+        ASSERT_TRUE(broker1->IsInTransaction());
+        ASSERT_TRUE(broker2->IsInTransaction());
+
+        stage1->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        stage2->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        stage1->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+        stage2->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+
+        // No notices are emitted during a transaction.
+        ASSERT_TRUE(received.empty());
+    }
+
+    ASSERT_FALSE(broker1->IsInTransaction());
+    ASSERT_FALSE(broker2->IsInTransaction());
+
+    // Notices are emitted in the order of the brokers.
+    ASSERT_EQ(received, std::vector<std::string>({"stage2", "stage1"}));
+}
+
+TEST_F(TransactionTest, MultiBrokerEditDuringClose)
+{
+    auto stage1 = PXR_NS::UsdStage::CreateInMemory();
+    auto stage2 = PXR_NS::UsdStage::CreateInMemory();
+
+    auto broker1 = unf::Broker::Create(stage1);
+    auto broker2 = unf::Broker::Create(stage2);
+
+    // Listener on first stage editing second stage.
+    broker1->AddConcurrentListener<unf::UnfNotice::ObjectsChanged>(
+        [&](const unf::UnfNotice::ObjectsChanged&) {
+            stage2->DefinePrim(PXR_NS::SdfPath{"/Foo/Child"});
+            stage2->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+        });
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer(stage2);
+
+    {
+        unf::MultiNoticeTransaction transaction(
+            std::vector<unf::BrokerPtr>{broker1, broker2});
+
+        stage1->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        stage2->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+    }
+
+    // Notices captured after the merge are merged again before being sent.
+    ASSERT_EQ(observer.Received(), 1);
+    ASSERT_EQ(
+        observer.GetLatestNotice().GetResyncedPaths(),
+        PXR_NS::SdfPathVector(
+            {PXR_NS::SdfPath{"/Bar"}, PXR_NS::SdfPath{"/Foo"}}));
+}
+
+TEST_F(TransactionTest, MultiBrokerFromStages)
+{
+    auto stage = PXR_NS::UsdStage::CreateInMemory();
+
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer1(_stage);
+    ::Test::Observer<unf::UnfNotice::ObjectsChanged> observer2(stage);
+
+    {
+        using StageContentsChanged = unf::UnfNotice::StageContentsChanged;
+
+        unf::MultiNoticeTransaction transaction(
+            std::vector<PXR_NS::UsdStageRefPtr>{_stage, stage},
+            unf::CapturePredicate::BlockTypes(
+                {PXR_NS::TfType::Find<StageContentsChanged>()}));
+
+        _stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+        stage->DefinePrim(PXR_NS::SdfPath{"/Foo"});
+
+        {
+            // Nested transactions are joined with the outer ones.
+            unf::NoticeTransaction nested(stage);
+            stage->DefinePrim(PXR_NS::SdfPath{"/Bar"});
+        }
+
+        ASSERT_EQ(observer1.Received(), 0);
+        ASSERT_EQ(observer2.Received(), 0);
+    }
+
+    ASSERT_EQ(observer1.Received(), 1);
+    ASSERT_EQ(observer2.Received(), 1);
+
+    ASSERT_EQ(
+        observer2.GetLatestNotice().GetResyncedPaths(),
+        PXR_NS::SdfPathVector({
+            PXR_NS::SdfPath{"/Bar"},
+            PXR_NS::SdfPath{"/Foo"},
+        }));
+}
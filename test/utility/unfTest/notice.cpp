@@ -1,10 +1,12 @@
 #include "notice.h"
 
 #include <unf/notice.h>
+#include <unf/serialization.h>
 
 #include <pxr/base/tf/notice.h>
 #include <pxr/pxr.h>
 
+#include <string>
 #include <utility>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -16,10 +18,24 @@ TF_REGISTRY_FUNCTION(TfType)
     TfType::
         Define<MergeableNotice, TfType::Bases<unf::UnfNotice::StageNotice> >();
 
+    unf::NoticeSerializationDefine<MergeableNotice>();
+
     TfType::Define<
         UnMergeableNotice,
         TfType::Bases<unf::UnfNotice::StageNotice> >();
 
+    TfType::Define<
+        KeepLatestNotice,
+        TfType::Bases<unf::UnfNotice::StageNotice> >();
+
+    TfType::Define<
+        KeepFirstAndLastNotice,
+        TfType::Bases<unf::UnfNotice::StageNotice> >();
+
+    TfType::Define<
+        BoundedRingNotice,
+        TfType::Bases<unf::UnfNotice::StageNotice> >();
+
     TfType::Define<InputNotice, TfType::Bases<TfNotice> >();
 
     TfType::
@@ -52,8 +68,45 @@ void MergeableNotice::Merge(MergeableNotice&& notice)
 
 const DataMap& MergeableNotice::GetData() const { return _data; }
 
+bool MergeableNotice::Serialize(unf::NoticeWriter& writer) const
+{
+    writer.WriteUInt32(static_cast<uint32_t>(_data.size()));
+    for (const auto& it : _data) {
+        writer.WriteString(it.first);
+        writer.WriteString(it.second);
+    }
+    return true;
+}
+
+TfRefPtr<MergeableNotice> MergeableNotice::Deserialize(
+    unf::NoticeReader& reader)
+{
+    DataMap data;
+    const uint32_t count = reader.ReadUInt32();
+    for (uint32_t i = 0; i < count && reader.IsValid(); ++i) {
+        std::string key = reader.ReadString();
+        data[key] = reader.ReadString();
+    }
+    return MergeableNotice::Create(data);
+}
+
 bool UnMergeableNotice::IsMergeable() const { return false; }
 
+unf::MergePolicy KeepLatestNotice::GetMergePolicy() const
+{
+    return unf::MergePolicy::KeepLatest();
+}
+
+unf::MergePolicy KeepFirstAndLastNotice::GetMergePolicy() const
+{
+    return unf::MergePolicy::KeepFirstAndLast();
+}
+
+unf::MergePolicy BoundedRingNotice::GetMergePolicy() const
+{
+    return unf::MergePolicy::BoundedRing(3);
+}
+
 InputNotice::InputNotice() {}
 
 OutputNotice1::OutputNotice1(const InputNotice&) {}
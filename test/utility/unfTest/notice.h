@@ -34,6 +34,11 @@ class MergeableNotice
 
     UNF_API const DataMap& GetData() const;
 
+    UNF_API virtual bool Serialize(unf::NoticeWriter& writer) const override;
+
+    UNF_API static PXR_NS::TfRefPtr<MergeableNotice> Deserialize(
+        unf::NoticeReader& reader);
+
   private:
     DataMap _data;
 };
@@ -48,6 +53,41 @@ class UnMergeableNotice
     UNF_API virtual bool IsMergeable() const;
 };
 
+// Notice holding an index to identify it within broker transactions.
+template <class Self>
+class IndexedNotice : public unf::UnfNotice::StageNoticeImpl<Self> {
+  public:
+    IndexedNotice(int index = 0) : _index(index) {}
+    virtual ~IndexedNotice() = default;
+
+    int GetIndex() const { return _index; }
+
+  private:
+    int _index;
+};
+
+// Notices consolidated with specific merge policies.
+class KeepLatestNotice : public IndexedNotice<KeepLatestNotice> {
+  public:
+    using IndexedNotice<KeepLatestNotice>::IndexedNotice;
+
+    UNF_API virtual unf::MergePolicy GetMergePolicy() const override;
+};
+
+class KeepFirstAndLastNotice : public IndexedNotice<KeepFirstAndLastNotice> {
+  public:
+    using IndexedNotice<KeepFirstAndLastNotice>::IndexedNotice;
+
+    UNF_API virtual unf::MergePolicy GetMergePolicy() const override;
+};
+
+class BoundedRingNotice : public IndexedNotice<BoundedRingNotice> {
+  public:
+    using IndexedNotice<BoundedRingNotice>::IndexedNotice;
+
+    UNF_API virtual unf::MergePolicy GetMergePolicy() const override;
+};
+
 // Declare notices used by the test dispatchers.
 class InputNotice : public PXR_NS::TfNotice {
   public: